@@ -0,0 +1,57 @@
+// This file is part of the Yttrium toolkit.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <yttrium/application/window.h>
+
+#include <seir_graphics/point.hpp>
+#include <seir_graphics/size.hpp>
+
+#include <optional>
+#include <string>
+
+namespace seir
+{
+	class Image;
+}
+
+namespace Yt
+{
+	class WindowBackendCallbacks;
+
+	// Headless window for the null renderer, which lets the rendering code
+	// run on machines without a display, e. g. in benchmarks.
+	class WindowBackend
+	{
+	public:
+		// The size of a headless window never changes.
+		static constexpr seir::Size FixedSize{ 1920, 1080 };
+
+		explicit WindowBackend(WindowBackendCallbacks&) noexcept {}
+
+		void close() noexcept { _closed = true; }
+		bool get_cursor(seir::Point& cursor) const noexcept
+		{
+			cursor = _cursor;
+			return true;
+		}
+		WindowID id() const noexcept { return { nullptr, 0 }; }
+		bool process_events() const noexcept { return !_closed; }
+		bool set_cursor(const seir::Point& cursor) noexcept
+		{
+			_cursor = cursor;
+			return true;
+		}
+		void set_icon(const seir::Image&) noexcept {}
+		void set_title(const std::string&) noexcept {}
+		void show() noexcept {}
+		std::optional<seir::Size> size() const noexcept { return FixedSize; }
+		void swap_buffers() noexcept {}
+
+	private:
+		bool _closed = false;
+		seir::Point _cursor{ FixedSize._width / 2, FixedSize._height / 2 };
+	};
+}
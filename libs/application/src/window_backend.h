@@ -4,7 +4,9 @@
 
 #pragma once
 
-#if defined(_WIN32)
+#if !YTTRIUM_RENDERER_OPENGL && !YTTRIUM_RENDERER_VULKAN
+#	include "null/window.h"
+#elif defined(_WIN32)
 #	include "windows/window.h"
 #elif YTTRIUM_RENDERER_OPENGL
 #	include "x11/window.h"
@@ -4,6 +4,7 @@
 
 #include "application.h"
 
+#include <yttrium/base/profiler.h>
 #include "../../../base/src/windows/error.h"
 
 #include <seir_base/int_utils.hpp>
@@ -39,6 +40,7 @@ namespace Yt
 
 	bool NativeApplication::process_events()
 	{
+		Y_PROFILE_SCOPE("WindowBackend::process_events");
 		// TODO: Process VK_SNAPSHOT, VK_{L,R}SHIFT, VK_{L,R}CONTROL, VK_{L,R}MENU.
 		MSG msg;
 		while (::PeekMessageW(&msg, NULL, 0, 0, PM_NOREMOVE))
@@ -5,6 +5,7 @@
 #include "window.h"
 
 #include <yttrium/base/exceptions.h>
+#include <yttrium/base/profiler.h>
 #include <yttrium/geometry/point.h>
 #include <yttrium/image/image.h>
 #include "../key_codes.h"
@@ -114,6 +115,7 @@ namespace Yt
 
 	bool WindowBackend::process_events()
 	{
+		Y_PROFILE_SCOPE("WindowBackend::process_events");
 		const auto check_autorepeat = [this](const ::XEvent& event) {
 			struct Query
 			{
@@ -4,6 +4,7 @@
 
 #include "window.h"
 
+#include <yttrium/base/profiler.h>
 #include <yttrium/image/image.h>
 #include "../key_codes.h"
 #include "../window_callbacks.h"
@@ -234,6 +235,7 @@ namespace Yt
 
 	bool WindowBackend::process_events()
 	{
+		Y_PROFILE_SCOPE("WindowBackend::process_events");
 		const auto do_key_event = [this](Key key, bool pressed, bool autorepeat, uint16_t state) {
 			if (key == Key::None)
 				return;
@@ -0,0 +1,17 @@
+// This file is part of the Yttrium toolkit.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <string_view>
+
+void benchmark_buffer_alloc();
+void benchmark_buffer_faults();
+void benchmark_buffer_growth();
+void benchmark_buffer_threads();
+void benchmark_logger_threads();
+void benchmark_mapped_load();
+
+// Adds a result of the current benchmark to the JSON report.
+void report(std::string_view name, double value, std::string_view unit);
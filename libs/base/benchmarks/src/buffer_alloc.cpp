@@ -0,0 +1,166 @@
+// This file is part of the Yttrium toolkit.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "benchmarks.h"
+
+#include <yttrium/base/buffer.h>
+#include "../../src/buffer_memory.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace
+{
+	constexpr size_t WorkingSet = 64;
+	constexpr size_t GrowthSteps = 16;
+
+	// Allocated pointers are stored here to prevent the compiler from eliding allocations.
+	void* volatile _sink = nullptr;
+
+	// Sizes around the boundary between small blocks and separate mappings.
+	constexpr std::array Sizes{
+		size_t{ 64 },
+		size_t{ 4096 },
+		Yt::BufferMemory::MaxSmallBlockSize / 8,
+		Yt::BufferMemory::MaxSmallBlockSize / 2,
+		Yt::BufferMemory::MaxSmallBlockSize,
+		Yt::BufferMemory::MaxSmallBlockSize + 1,
+		Yt::BufferMemory::MaxSmallBlockSize * 2,
+		Yt::BufferMemory::MaxSmallBlockSize * 8,
+	};
+
+	struct BufferBlock
+	{
+		static constexpr const char* Name = "Buffer";
+		Yt::Buffer _buffer;
+		void allocate(size_t size) { _buffer = Yt::Buffer{ size }; }
+		void* data() noexcept { return _buffer.data(); }
+		void free() { _buffer = {}; }
+		void grow(size_t old_size, size_t new_size)
+		{
+			_buffer.resize(new_size);
+			std::memset(_buffer.begin() + old_size, 1, new_size - old_size);
+		}
+	};
+
+	struct MallocBlock
+	{
+		static constexpr const char* Name = "malloc";
+		void* _data = nullptr;
+		~MallocBlock() { std::free(_data); }
+		void allocate(size_t size) { _data = std::malloc(size); }
+		void* data() noexcept { return _data; }
+		void free() { std::free(std::exchange(_data, nullptr)); }
+		void grow(size_t old_size, size_t new_size)
+		{
+			_data = std::realloc(_data, new_size);
+			std::memset(static_cast<std::byte*>(_data) + old_size, 1, new_size - old_size);
+		}
+	};
+
+	struct VectorBlock
+	{
+		static constexpr const char* Name = "std::vector";
+		std::vector<std::byte> _vector;
+		void allocate(size_t size) { _vector.reserve(size); }
+		void* data() noexcept { return _vector.data(); }
+		void free() { _vector = std::vector<std::byte>{}; }
+		void grow(size_t, size_t new_size) { _vector.resize(new_size, std::byte{ 1 }); }
+	};
+
+	// Frees and allocates random blocks of the same size from a working set.
+	template <typename Block>
+	void allocate_free(size_t size, size_t iterations, uint32_t seed)
+	{
+		std::array<Block, WorkingSet> blocks;
+		auto random = seed;
+		for (auto n = iterations; n > 0; --n)
+		{
+			random ^= random << 13;
+			random ^= random >> 17;
+			random ^= random << 5;
+			auto& block = blocks[random % WorkingSet];
+			block.free();
+			block.allocate(size);
+			_sink = block.data();
+		}
+	}
+
+	// Grows a block to the specified size in equal steps, writing the added memory.
+	template <typename Block>
+	void grow_free(size_t size, size_t iterations, uint32_t)
+	{
+		const auto step = (size + GrowthSteps - 1) / GrowthSteps;
+		for (auto n = iterations; n > 0; --n)
+		{
+			Block block;
+			for (size_t old_size = 0; old_size < size;)
+			{
+				const auto new_size = std::min(old_size + step, size);
+				block.grow(old_size, new_size);
+				old_size = new_size;
+			}
+			_sink = block.data();
+		}
+	}
+
+	using Function = void (*)(size_t size, size_t iterations, uint32_t seed);
+
+	// Returns the time per iteration of the function running concurrently in the specified number of threads.
+	double measure(Function function, size_t size, size_t iterations, size_t thread_count)
+	{
+		std::atomic<bool> start{ false };
+		std::vector<std::thread> threads;
+		threads.reserve(thread_count);
+		for (size_t i = 0; i < thread_count; ++i)
+			threads.emplace_back([&start, function, size, iterations, seed = static_cast<uint32_t>(2'463'534'242u + i)] {
+				while (!start.load(std::memory_order_acquire))
+					std::this_thread::yield();
+				function(size, iterations, seed);
+			});
+		const auto start_time = std::chrono::steady_clock::now();
+		start.store(true, std::memory_order_release);
+		for (auto& thread : threads)
+			thread.join();
+		return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start_time).count() / static_cast<double>(iterations);
+	}
+
+	// Runs the pattern for each allocator, scaling the iteration count inversely to the block size.
+	void run(const char* pattern, const std::array<Function, 3>& functions, size_t min_iterations, size_t max_iterations, size_t threads)
+	{
+		constexpr std::array names{ BufferBlock::Name, MallocBlock::Name, VectorBlock::Name };
+		std::printf("%s, %zu thread%s (ns/op):\n", pattern, threads, threads == 1 ? "" : "s");
+		std::printf("%10s  %10s  %10s  %11s\n", "size", names[0], names[1], names[2]);
+		for (const auto size : Sizes)
+		{
+			const auto iterations = std::clamp((size_t{ 1 } << 30) / size, min_iterations, max_iterations);
+			std::array<double, 3> results{};
+			for (size_t i = 0; i < functions.size(); ++i)
+			{
+				results[i] = measure(functions[i], size, iterations, threads);
+				report(std::string{ pattern } + '/' + names[i] + '/' + std::to_string(size) + "/threads=" + std::to_string(threads), results[i], "ns/op");
+			}
+			std::printf("%10zu  %10.1f  %10.1f  %11.1f\n", size, results[0], results[1], results[2]);
+		}
+	}
+}
+
+void benchmark_buffer_alloc()
+{
+	const auto max_threads = std::max<size_t>(4, std::thread::hardware_concurrency());
+	for (const auto threads : { size_t{ 1 }, max_threads })
+	{
+		run("allocate_free", { allocate_free<BufferBlock>, allocate_free<MallocBlock>, allocate_free<VectorBlock> }, 10'000, 1'000'000, threads);
+		run("grow_free", { grow_free<BufferBlock>, grow_free<MallocBlock>, grow_free<VectorBlock> }, 100, 100'000, threads);
+	}
+}
@@ -0,0 +1,71 @@
+// This file is part of the Yttrium toolkit.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "benchmarks.h"
+
+#include <yttrium/base/buffer.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#ifndef _WIN32
+#	include <sys/resource.h>
+#endif
+
+namespace
+{
+	constexpr size_t BufferSize = size_t{ 64 } << 20;
+
+#ifndef _WIN32
+	long page_faults() noexcept
+	{
+		::rusage usage;
+		::getrusage(RUSAGE_SELF, &usage);
+		return usage.ru_minflt + usage.ru_majflt;
+	}
+
+	// Measures page faults and time of a buffer allocation and of the first write to all of its memory.
+	void measure(const char* name, Yt::Flags<Yt::Buffer::Hint> hints)
+	{
+		Yt::Buffer buffer;
+		buffer.set_hints(hints);
+		const auto allocation_faults = page_faults();
+		const auto allocation_time = std::chrono::steady_clock::now();
+		buffer.reset(BufferSize);
+		const auto touch_faults = page_faults();
+		const auto touch_time = std::chrono::steady_clock::now();
+		std::memset(buffer.data(), 1, buffer.size());
+		const auto end_faults = page_faults();
+		const auto end_time = std::chrono::steady_clock::now();
+		const auto allocation_ms = std::chrono::duration<double, std::milli>(touch_time - allocation_time).count();
+		const auto touch_ms = std::chrono::duration<double, std::milli>(end_time - touch_time).count();
+		std::printf("%-22s  %6ld  %8.3f  %6ld  %8.3f\n", name, touch_faults - allocation_faults, allocation_ms, end_faults - touch_faults, touch_ms);
+		const std::string prefix = name;
+		report(prefix + "/allocation", allocation_ms, "ms");
+		report(prefix + "/allocation_faults", static_cast<double>(touch_faults - allocation_faults), "faults");
+		report(prefix + "/first_write", touch_ms, "ms");
+		report(prefix + "/first_write_faults", static_cast<double>(end_faults - touch_faults), "faults");
+	}
+#endif
+}
+
+void benchmark_buffer_faults()
+{
+#ifndef _WIN32
+	using namespace Yt::Operators;
+	using Hint = Yt::Buffer::Hint;
+	std::printf("Allocating and writing %zu MiB:\n", BufferSize >> 20);
+	std::printf("hints                   allocation        first write\n");
+	std::printf("                        faults  ms        faults  ms\n");
+	measure("none", {});
+	measure("Populate", Hint::Populate);
+	measure("HugePages", Hint::HugePages);
+	measure("HugePages + Populate", Hint::HugePages | Hint::Populate);
+	measure("Lock", Hint::Lock);
+#else
+	std::printf("Page fault counting is not supported on this platform.\n");
+#endif
+}
@@ -0,0 +1,85 @@
+// This file is part of the Yttrium toolkit.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "benchmarks.h"
+
+#include <yttrium/base/buffer.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+#ifdef __linux__
+#	include <sys/mman.h>
+#endif
+
+namespace
+{
+	constexpr size_t MaxSize = size_t{ 256 } << 20;
+	constexpr size_t Step = size_t{ 8 } << 20;
+
+	template <typename Function>
+	void measure(const char* name, Function&& function)
+	{
+		const auto start_time = std::chrono::steady_clock::now();
+		function();
+		const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+		std::printf("%-24s  %7.3f\n", name, seconds);
+		report(name, seconds, "s");
+	}
+
+	void grow_buffer(Yt::Buffer& buffer)
+	{
+		for (size_t size = Step; size <= MaxSize; size += Step)
+		{
+			buffer.resize(size);
+			std::memset(buffer.begin() + size - Step, 1, Step);
+		}
+	}
+
+#ifdef __linux__
+	template <typename Reallocate>
+	void grow_mapping(Reallocate&& reallocate)
+	{
+		auto data = ::mmap(nullptr, Step, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		std::memset(data, 1, Step);
+		for (size_t size = 2 * Step; size <= MaxSize; size += Step)
+		{
+			data = reallocate(data, size - Step, size);
+			std::memset(static_cast<std::byte*>(data) + size - Step, 1, Step);
+		}
+		::munmap(data, MaxSize);
+	}
+#endif
+}
+
+void benchmark_buffer_growth()
+{
+	std::printf("Growing to %zu MiB in %zu MiB steps:\n", MaxSize >> 20, Step >> 20);
+	std::printf("strategy                  seconds\n");
+	measure("Buffer", [] {
+		Yt::Buffer buffer;
+		grow_buffer(buffer);
+	});
+	measure("Buffer (reserved)", [] {
+		Yt::Buffer buffer;
+		buffer.reserve_address_space(MaxSize);
+		grow_buffer(buffer);
+	});
+#ifdef __linux__
+	measure("mmap + memcpy + munmap", [] {
+		grow_mapping([](void* old_data, size_t old_size, size_t new_size) {
+			const auto new_data = ::mmap(nullptr, new_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+			std::memcpy(new_data, old_data, old_size);
+			::munmap(old_data, old_size);
+			return new_data;
+		});
+	});
+	measure("mremap", [] {
+		grow_mapping([](void* old_data, size_t old_size, size_t new_size) {
+			return ::mremap(old_data, old_size, new_size, MREMAP_MAYMOVE);
+		});
+	});
+#endif
+}
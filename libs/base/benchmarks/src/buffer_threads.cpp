@@ -0,0 +1,68 @@
+// This file is part of the Yttrium toolkit.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "benchmarks.h"
+
+#include <yttrium/base/buffer.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	constexpr size_t Iterations = 1'000'000;
+	constexpr size_t WorkingSet = 64;
+	constexpr size_t MaxBufferSize = 64 * 1024;
+
+	// Replaces random buffers from a per-thread working set with buffers of random sizes.
+	void churn(uint32_t seed, const std::atomic<bool>& start)
+	{
+		std::array<Yt::Buffer, WorkingSet> buffers;
+		auto random = seed;
+		while (!start.load(std::memory_order_acquire))
+			std::this_thread::yield();
+		for (size_t i = 0; i < Iterations; ++i)
+		{
+			random ^= random << 13;
+			random ^= random >> 17;
+			random ^= random << 5;
+			buffers[random % WorkingSet] = Yt::Buffer{ 1 + (random >> 8) % MaxBufferSize };
+		}
+	}
+
+	double run(size_t thread_count)
+	{
+		std::atomic<bool> start{ false };
+		std::vector<std::thread> threads;
+		threads.reserve(thread_count);
+		for (size_t i = 0; i < thread_count; ++i)
+			threads.emplace_back(churn, static_cast<uint32_t>(2'463'534'242u + i), std::cref(start));
+		const auto start_time = std::chrono::steady_clock::now();
+		start.store(true, std::memory_order_release);
+		for (auto& thread : threads)
+			thread.join();
+		return std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+	}
+}
+
+void benchmark_buffer_threads()
+{
+	const auto max_threads = std::max<size_t>(4, std::thread::hardware_concurrency());
+	std::printf("Replacing buffers of up to %zu KiB:\n", MaxBufferSize >> 10);
+	std::printf("threads  seconds  ns/op  Mops/s\n");
+	for (size_t threads = 1; threads <= max_threads; threads *= 2)
+	{
+		const auto seconds = run(threads);
+		const auto operations = static_cast<double>(threads * Iterations);
+		const auto ns_per_operation = seconds * 1e9 / static_cast<double>(Iterations);
+		std::printf("%7zu  %7.3f  %5.1f  %6.2f\n", threads, seconds, ns_per_operation, operations / seconds / 1e6);
+		report("threads=" + std::to_string(threads), ns_per_operation, "ns/op");
+	}
+}
@@ -0,0 +1,253 @@
+// This file is part of the Yttrium toolkit.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "benchmarks.h"
+
+#include <yttrium/base/log_sink.h>
+#include <yttrium/base/logger.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	constexpr size_t MessagesPerThread = 100'000;
+	constexpr std::array<size_t, 3> ThreadCounts{ 1, 4, 16 };
+	constexpr size_t MessageSize = 64;
+
+	constexpr auto RateTrialDuration = std::chrono::milliseconds{ 250 };
+	constexpr double InitialRate = 250'000;
+	constexpr double MaxRate = 64'000'000;
+	constexpr int RateRefinements = 4;
+
+	using Clock = std::chrono::steady_clock;
+
+	enum class SinkType
+	{
+		Null,
+		File,
+	};
+
+	const char* sink_name(SinkType type) noexcept
+	{
+		return type == SinkType::File ? "file" : "null";
+	}
+
+	std::filesystem::path log_path()
+	{
+		return std::filesystem::temp_directory_path() / "yttrium_benchmark_logger.log";
+	}
+
+	std::unique_ptr<Yt::LogSink> open_file_sink(SinkType type)
+	{
+		if (type != SinkType::File)
+			return {};
+		std::error_code error;
+		std::filesystem::remove(log_path(), error);
+		auto file = Yt::LogSink::open_file(log_path());
+		if (!file)
+			std::fprintf(stderr, "Unable to open %s\n", log_path().string().c_str());
+		return file;
+	}
+
+	// Measures the latency of every benchmark message, then passes the batch to the file sink, if any.
+	class LatencySink final : public Yt::LogSink
+	{
+	public:
+		LatencySink(std::vector<Clock::duration>& latencies, std::unique_ptr<Yt::LogSink>&& file) noexcept
+			: _latencies{ latencies }, _file{ std::move(file) } {}
+
+		void write(std::span<const std::string_view> messages) override
+		{
+			const auto now = Clock::now().time_since_epoch();
+			for (const auto message : messages)
+			{
+				if (message.size() != MessageSize)
+					continue; // Dropped message report.
+				Clock::rep written = 0;
+				std::memcpy(&written, message.data(), sizeof written);
+				_latencies.emplace_back(now - Clock::duration{ written });
+			}
+			if (_file)
+				_file->write(messages);
+		}
+
+	private:
+		std::vector<Clock::duration>& _latencies;
+		const std::unique_ptr<Yt::LogSink> _file;
+	};
+
+	// Counts benchmark messages without allocating, then passes the batch to the file sink, if any.
+	class CountingSink final : public Yt::LogSink
+	{
+	public:
+		CountingSink(size_t& delivered, std::unique_ptr<Yt::LogSink>&& file) noexcept
+			: _delivered{ delivered }, _file{ std::move(file) } {}
+
+		void write(std::span<const std::string_view> messages) override
+		{
+			_delivered += static_cast<size_t>(std::count_if(messages.begin(), messages.end(), [](std::string_view message) { return message.size() == MessageSize; }));
+			if (_file)
+				_file->write(messages);
+		}
+
+	private:
+		size_t& _delivered;
+		const std::unique_ptr<Yt::LogSink> _file;
+	};
+
+	// Each message starts with the time it was written at, so the sink can measure the latency.
+	void write_message(std::string& message)
+	{
+		const auto now = Clock::now().time_since_epoch().count();
+		std::memcpy(message.data(), &now, sizeof now);
+		Yt::Logger::write(message);
+	}
+
+	// Starts the producers at once and waits for them to finish.
+	template <typename Function>
+	void run_producers(size_t thread_count, Function&& function)
+	{
+		std::atomic<bool> start{ false };
+		std::vector<std::thread> threads;
+		threads.reserve(thread_count);
+		for (size_t i = 0; i < thread_count; ++i)
+			threads.emplace_back([&start, &function] {
+				while (!start.load(std::memory_order_acquire))
+					std::this_thread::yield();
+				function();
+			});
+		start.store(true, std::memory_order_release);
+		for (auto& thread : threads)
+			thread.join();
+	}
+
+	struct BurstResult
+	{
+		double _write_ns = 0;
+		double _messages_per_second = 0;
+		size_t _delivered = 0;
+		double _latency_p50_us = 0;
+		double _latency_p99_us = 0;
+		double _latency_max_us = 0;
+	};
+
+	// Every producer writes as fast as it can, so the buffer overflows if the sink can't keep up.
+	BurstResult run_burst(SinkType sink, size_t thread_count)
+	{
+		std::vector<Clock::duration> latencies;
+		latencies.reserve(thread_count * MessagesPerThread);
+		Yt::Logger logger{ std::make_unique<LatencySink>(latencies, open_file_sink(sink)) };
+		std::atomic<int64_t> write_time{ 0 };
+		const auto start_time = Clock::now();
+		run_producers(thread_count, [&write_time] {
+			std::string message(MessageSize, '.');
+			const auto thread_start_time = Clock::now();
+			for (size_t i = 0; i < MessagesPerThread; ++i)
+				write_message(message);
+			write_time.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - thread_start_time).count());
+		});
+		Yt::Logger::flush();
+		const auto seconds = std::chrono::duration<double>(Clock::now() - start_time).count();
+
+		BurstResult result;
+		result._write_ns = static_cast<double>(write_time.load()) / static_cast<double>(thread_count * MessagesPerThread);
+		result._delivered = latencies.size();
+		result._messages_per_second = static_cast<double>(latencies.size()) / seconds;
+		if (!latencies.empty())
+		{
+			const auto microseconds = [&latencies](size_t index) { return std::chrono::duration<double, std::micro>(latencies[index]).count(); };
+			std::sort(latencies.begin(), latencies.end());
+			result._latency_p50_us = microseconds(latencies.size() / 2);
+			result._latency_p99_us = microseconds(latencies.size() * 99 / 100);
+			result._latency_max_us = microseconds(latencies.size() - 1);
+		}
+		return result;
+	}
+
+	// Returns true if the producers can write at the specified total rate without any messages dropped.
+	bool sustains(SinkType sink, size_t thread_count, double rate)
+	{
+		size_t delivered = 0;
+		Yt::Logger logger{ std::make_unique<CountingSink>(delivered, open_file_sink(sink)) };
+		const auto thread_rate = rate / static_cast<double>(thread_count);
+		run_producers(thread_count, [thread_rate] {
+			std::string message(MessageSize, '.');
+			const auto start_time = Clock::now();
+			size_t written = 0;
+			for (auto elapsed = Clock::duration{}; elapsed < RateTrialDuration; elapsed = Clock::now() - start_time)
+			{
+				const auto target = static_cast<size_t>(thread_rate * std::chrono::duration<double>(elapsed).count());
+				if (written == target)
+					std::this_thread::yield();
+				for (; written < target; ++written)
+					write_message(message);
+			}
+		});
+		Yt::Logger::flush();
+		const auto expected = rate * std::chrono::duration<double>(RateTrialDuration).count();
+		return Yt::Logger::statistics()._dropped_messages == 0 && static_cast<double>(delivered) >= 0.95 * expected;
+	}
+
+	// Doubles the rate until it can't be sustained, then narrows the range down.
+	double max_sustained_rate(SinkType sink, size_t thread_count)
+	{
+		double sustained = 0;
+		double failed = InitialRate;
+		for (; failed <= MaxRate && sustains(sink, thread_count, failed); failed *= 2)
+			sustained = failed;
+		if (failed > MaxRate)
+			return sustained;
+		for (int i = 0; i < RateRefinements; ++i)
+		{
+			const auto rate = (sustained + failed) / 2;
+			(sustains(sink, thread_count, rate) ? sustained : failed) = rate;
+		}
+		return sustained;
+	}
+}
+
+void benchmark_logger_threads()
+{
+	constexpr std::array sinks{ SinkType::Null, SinkType::File };
+
+	std::printf("Writing %zu messages per thread at once:\n", MessagesPerThread);
+	std::printf("sink  threads  ns/write  Mmsg/s  delivered  p50 us  p99 us   max us\n");
+	for (const auto sink : sinks)
+		for (const auto threads : ThreadCounts)
+		{
+			const auto result = run_burst(sink, threads);
+			std::printf("%-4s  %7zu  %8.1f  %6.2f  %8.1f%%  %6.1f  %6.1f  %7.1f\n", sink_name(sink), threads, result._write_ns, result._messages_per_second / 1e6,
+				100.0 * static_cast<double>(result._delivered) / static_cast<double>(threads * MessagesPerThread),
+				result._latency_p50_us, result._latency_p99_us, result._latency_max_us);
+			const auto suffix = std::string{ "/" } + sink_name(sink) + "/threads=" + std::to_string(threads);
+			report("write" + suffix, result._write_ns, "ns");
+			report("throughput" + suffix, result._messages_per_second, "msg/s");
+			report("delivered" + suffix, static_cast<double>(result._delivered), "msg");
+			report("latency_p50" + suffix, result._latency_p50_us, "us");
+			report("latency_p99" + suffix, result._latency_p99_us, "us");
+			report("latency_max" + suffix, result._latency_max_us, "us");
+		}
+
+	std::printf("\nMaximum rate without drops:\n");
+	std::printf("sink  threads  Mmsg/s\n");
+	for (const auto sink : sinks)
+		for (const auto threads : ThreadCounts)
+		{
+			const auto rate = max_sustained_rate(sink, threads);
+			std::printf("%-4s  %7zu  %6.2f\n", sink_name(sink), threads, rate / 1e6);
+			report(std::string{ "sustained/" } + sink_name(sink) + "/threads=" + std::to_string(threads), rate, "msg/s");
+		}
+
+	std::error_code error;
+	std::filesystem::remove(log_path(), error);
+}
@@ -0,0 +1,108 @@
+// This file is part of the Yttrium toolkit.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "benchmarks.h"
+
+#include <yttrium/base/buffer.h>
+#include <yttrium/base/mapped_buffer.h>
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+#	include <fcntl.h>
+#	include <unistd.h>
+#endif
+
+namespace
+{
+	constexpr size_t FileSize = size_t{ 256 } << 20;
+
+	// Reads every page of the data to make sure it is loaded.
+	uint64_t consume(const uint8_t* data, size_t size) noexcept
+	{
+		uint64_t result = 0;
+		for (size_t i = 0; i < size; i += 4096)
+			result += data[i];
+		return result;
+	}
+
+	uint64_t load_copy(const std::filesystem::path& path)
+	{
+		std::ifstream stream{ path, std::ios::binary };
+		Yt::Buffer buffer{ static_cast<size_t>(std::filesystem::file_size(path)) };
+		stream.read(static_cast<char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+		return consume(buffer.begin(), buffer.size());
+	}
+
+	uint64_t load_mapped(const std::filesystem::path& path, Yt::Flags<Yt::MappedBuffer::Hint> hints)
+	{
+		const auto mapped = Yt::MappedBuffer::open(path, hints);
+		return mapped ? consume(mapped->begin(), mapped->size()) : 0;
+	}
+
+	// Drops the file from the page cache, which makes the next load cold.
+	bool evict(const std::filesystem::path& path)
+	{
+#if defined(__linux__)
+		const auto descriptor = ::open(path.c_str(), O_RDONLY);
+		if (descriptor == -1)
+			return false;
+		::fdatasync(descriptor);
+		const auto result = ::posix_fadvise(descriptor, 0, 0, POSIX_FADV_DONTNEED) == 0;
+		::close(descriptor);
+		return result;
+#else
+		static_cast<void>(path);
+		return false;
+#endif
+	}
+
+	template <typename Function>
+	void measure(const char* name, const std::filesystem::path& path, Function&& function)
+	{
+		std::printf("%-30s", name);
+		for (const auto cold : { true, false })
+		{
+			if (cold && !evict(path))
+			{
+				std::printf("  %8s", "-");
+				continue;
+			}
+			const auto start_time = std::chrono::steady_clock::now();
+			[[maybe_unused]] volatile auto sum = function(path);
+			const auto milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_time).count();
+			std::printf("  %8.3f", milliseconds);
+			report(std::string{ name } + (cold ? "/cold" : "/warm"), milliseconds, "ms");
+		}
+		std::printf("\n");
+	}
+}
+
+void benchmark_mapped_load()
+{
+	using namespace Yt::Operators;
+	using Hint = Yt::MappedBuffer::Hint;
+	const auto path = std::filesystem::temp_directory_path() / "yttrium_benchmark_mapped_load";
+	{
+		std::vector<char> data(1 << 20);
+		for (size_t i = 0; i < data.size(); ++i)
+			data[i] = static_cast<char>(i * 7);
+		std::ofstream stream{ path, std::ios::binary };
+		for (size_t i = 0; i < FileSize / data.size(); ++i)
+			stream.write(data.data(), static_cast<std::streamsize>(data.size()));
+	}
+	std::printf("Loading a %zu MiB file (ms):\n", FileSize >> 20);
+	std::printf("method                              cold      warm\n");
+	measure("read into Buffer", path, load_copy);
+	measure("MappedBuffer", path, [](const auto& p) { return load_mapped(p, {}); });
+	measure("MappedBuffer (Sequential)", path, [](const auto& p) { return load_mapped(p, Hint::Sequential); });
+	measure("MappedBuffer (WillNeed)", path, [](const auto& p) { return load_mapped(p, Hint::WillNeed); });
+	measure("MappedBuffer (both)", path, [](const auto& p) { return load_mapped(p, Hint::Sequential | Hint::WillNeed); });
+	std::error_code error;
+	std::filesystem::remove(path, error);
+}
@@ -0,0 +1,72 @@
+// This file is part of the Yttrium toolkit.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstdint>
+
+namespace Yt
+{
+	/// Numbers of heap allocations made by a thread so far.
+	struct AllocationCounters
+	{
+		/// Buffer memory allocations, including the ones made to grow a buffer.
+		uint64_t _buffer_allocations = 0;
+
+		/// Global \c operator \c new calls, counted only if AllocationTracker::tracks_new() is true.
+		uint64_t _heap_allocations = 0;
+	};
+
+	/// What NoAllocationScope does about allocations made inside it.
+	enum class NoAllocationPolicy
+	{
+		Count,  ///< Only count them.
+		Report, ///< Log a warning with the number of allocations when the scope ends.
+		Abort,  ///< Abort the program at the first allocation, so that a debugger shows where it is made.
+	};
+
+	/// Heap allocation tracking.
+	class AllocationTracker
+	{
+	public:
+		/// Returns the allocation counters of the current thread.
+		static AllocationCounters counters() noexcept;
+
+		/// Sets the policy for all subsequent NoAllocationScope violations.
+		/// The default policy is NoAllocationPolicy::Report.
+		static void set_no_allocation_policy(NoAllocationPolicy) noexcept;
+
+		/// Returns true if global \c operator \c new calls are counted (see YTTRIUM_TRACK_NEW).
+		static bool tracks_new() noexcept;
+	};
+
+	/// Checks that the current thread makes no allocations until the scope ends.
+	class NoAllocationScope
+	{
+	public:
+		/// The name is used to report the violations and must outlive the scope.
+		explicit NoAllocationScope(const char* name) noexcept;
+		~NoAllocationScope() noexcept;
+
+		/// Returns the number of allocations made in the scope so far.
+		uint64_t allocations() const noexcept;
+
+		NoAllocationScope(const NoAllocationScope&) = delete;
+		NoAllocationScope& operator=(const NoAllocationScope&) = delete;
+
+	private:
+		const char* const _name;
+		const AllocationCounters _start;
+	};
+}
+
+#define Y_NO_ALLOCATIONS_CONCATENATE_(a, b) a##b
+#define Y_NO_ALLOCATIONS_CONCATENATE(a, b) Y_NO_ALLOCATIONS_CONCATENATE_(a, b)
+
+/// Checks that the rest of the enclosing scope makes no allocations in debug builds.
+#ifndef NDEBUG
+#	define Y_NO_ALLOCATIONS(name) const ::Yt::NoAllocationScope Y_NO_ALLOCATIONS_CONCATENATE(y_no_allocations_, __LINE__)(name)
+#else
+#	define Y_NO_ALLOCATIONS(name) static_cast<void>(0)
+#endif
@@ -4,22 +4,93 @@
 
 #pragma once
 
+#include <yttrium/base/flags.h>
+
 #include <cstddef>
 #include <cstdint>
 
 namespace Yt
 {
+	/// Buffer memory usage statistics.
+	struct BufferStatistics
+	{
+		/// Number of small block sizes, from one byte to the size of a chunk the blocks are split from.
+		static constexpr size_t LevelCount = 21;
+
+		/// Small block statistics for a single block size.
+		struct Level
+		{
+			/// Number of blocks allocated so far.
+			size_t _allocations = 0;
+
+			/// Number of blocks deallocated so far.
+			size_t _deallocations = 0;
+
+			/// Free memory in the shared pool.
+			size_t _free_bytes = 0;
+
+			/// Free memory cached by threads.
+			size_t _cached_bytes = 0;
+		};
+
+		/// Address space currently mapped for buffer memory.
+		size_t _mapped_bytes = 0;
+
+		/// Maximum address space mapped for buffer memory at once.
+		size_t _peak_mapped_bytes = 0;
+
+		/// Memory currently allocated for buffers.
+		size_t _allocated_bytes = 0;
+
+		/// Number of buffers allocated directly from the operating system so far.
+		size_t _large_allocations = 0;
+
+		/// Number of buffers deallocated directly to the operating system so far.
+		size_t _large_deallocations = 0;
+
+		/// Memory currently allocated for buffers directly from the operating system.
+		size_t _large_bytes = 0;
+
+		/// Small block statistics indexed by the binary logarithm of block size.
+		Level _levels[LevelCount];
+	};
+
 	/// Memory buffer.
-	/// Buffer memory is allocated in whole pages making each allocation big and very aligned.
+	/// Buffers of up to 512 KiB are allocated from a shared pool in power-of-two blocks of at least 64 bytes
+	/// aligned to their size, and blocks of up to 64 KiB are cached by the allocating threads.
+	/// Larger buffers are allocated directly from the operating system in whole pages.
 	class Buffer
 	{
 	public:
+		/// Buffer memory allocation hints.
+		enum class Hint
+		{
+			/// Back the memory with physical pages when it is allocated rather than when it is first accessed.
+			Populate = 1 << 0,
+
+			/// Use transparent huge pages for buffers allocated directly from the operating system.
+			HugePages = 1 << 1,
+
+			/// Lock buffers allocated directly from the operating system in physical memory.
+			Lock = 1 << 2,
+		};
+
+		/// Tag for creating page-aligned buffers.
+		struct PageAligned
+		{
+		};
+
 		/// Creates a buffer with no data.
 		constexpr Buffer() noexcept = default;
 
 		/// Creates a buffer of the specified size with uninitialized contents.
+		/// Buffers smaller than a memory page may share pages with other buffers.
 		explicit Buffer(size_t);
 
+		/// Creates a page-aligned buffer of the specified size with uninitialized contents.
+		/// The buffer capacity is at least one memory page, so the buffer remains page-aligned as it grows.
+		Buffer(size_t, PageAligned);
+
 		///
 		Buffer(size_t, const void*);
 
@@ -44,6 +115,10 @@ namespace Yt
 		///
 		void reserve(size_t);
 
+		/// Reserves address space for the buffer to grow up to the specified capacity without moving its data.
+		/// Memory is committed only as the buffer grows, and growing beyond the reserved capacity moves the data.
+		void reserve_address_space(size_t);
+
 		/// Changes the buffer size without preserving its contents.
 		void reset(size_t);
 
@@ -51,6 +126,11 @@ namespace Yt
 		/// Does not change the capacity if it is not less than the new size.
 		void resize(size_t);
 
+		/// Sets memory allocation hints for the buffer.
+		/// The hints apply to the memory already allocated for the buffer and to all further allocations.
+		/// Small buffers share memory with other buffers, so only Hint::Populate affects them.
+		void set_hints(Flags<Hint>) noexcept;
+
 		/// Returns the requested size of the buffer.
 		constexpr size_t size() const noexcept { return _size; }
 
@@ -70,6 +150,19 @@ namespace Yt
 		/// Returns the granularity of buffer memory, i.e. the size of a memory page.
 		static size_t memory_granularity() noexcept;
 
+		/// Returns buffer memory usage statistics.
+		/// The statistics are collected all the time, and taking a snapshot is cheap enough to do it every frame.
+		static BufferStatistics memory_statistics() noexcept;
+
+		/// Sets the amount of unused buffer memory to keep for future allocations.
+		/// Unused memory above this amount is returned to the operating system as soon as it becomes free.
+		static void set_retained_memory(size_t bytes) noexcept;
+
+		/// Returns unused buffer memory to the operating system.
+		/// Memory cached by threads other than the calling one is not affected.
+		/// Returns the number of bytes returned.
+		static size_t trim_memory() noexcept;
+
 		Buffer(const Buffer&) = delete;
 		Buffer(Buffer&&) noexcept;
 		~Buffer() noexcept;
@@ -77,12 +170,15 @@ namespace Yt
 		Buffer& operator=(Buffer&&) noexcept;
 
 	private:
+		void deallocate() noexcept;
 		bool try_grow(size_t allocate_bytes, size_t copy_bytes, bool do_resize) noexcept;
 
 	private:
 		size_t _size = 0;
 		size_t _capacity = 0;
 		void* _data = nullptr;
+		size_t _reserved = 0; // Reserved address space if the capacity is committed in place.
+		Flags<Hint> _hints;
 	};
 
 	bool operator==(const Buffer&, const Buffer&) noexcept;
@@ -0,0 +1,150 @@
+// This file is part of the Yttrium toolkit.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <yttrium/base/buffer.h>
+
+#include <cassert>
+#include <cstring>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+namespace Yt
+{
+	/// Array of trivially copyable values stored in a Buffer.
+	/// Unlike BufferAppender, it grows the buffer geometrically and keeps the end pointers,
+	/// so appending values doesn't involve the buffer until it runs out of capacity.
+	template <typename T>
+	class BufferVector
+	{
+		static_assert(std::is_trivially_copyable_v<T>);
+
+	public:
+		/// Creates an empty vector.
+		BufferVector() noexcept = default;
+
+		/// Creates a vector from the buffer contents.
+		explicit BufferVector(Buffer&& buffer) noexcept
+			: _buffer{ std::move(buffer) }
+			, _end{ begin() + _buffer.size() / sizeof(T) }
+			, _limit{ begin() + _buffer.capacity() / sizeof(T) }
+		{
+			assert(_buffer.size() % sizeof(T) == 0);
+			buffer = {};
+		}
+
+		///
+		BufferVector(BufferVector&& other) noexcept
+			: _buffer{ std::move(other._buffer) }
+			, _end{ std::exchange(other._end, nullptr) }
+			, _limit{ std::exchange(other._limit, nullptr) }
+		{
+			other._buffer = {};
+		}
+
+		///
+		BufferVector& operator=(BufferVector&& other) noexcept
+		{
+			_buffer = std::exchange(other._buffer, Buffer{});
+			_end = std::exchange(other._end, nullptr);
+			_limit = std::exchange(other._limit, nullptr);
+			return *this;
+		}
+
+		/// Appends values from the span.
+		void append(std::span<const T> values)
+		{
+			std::memcpy(emplace_n(values.size()), values.data(), values.size_bytes());
+		}
+
+		///
+		T* begin() noexcept { return static_cast<T*>(_buffer.data()); }
+		const T* begin() const noexcept { return static_cast<const T*>(_buffer.data()); }
+
+		/// Returns the number of values the vector can hold without reallocation.
+		size_t capacity() const noexcept { return static_cast<size_t>(_limit - begin()); }
+
+		///
+		void clear() noexcept { _end = begin(); }
+
+		///
+		T* data() noexcept { return begin(); }
+		const T* data() const noexcept { return begin(); }
+
+		/// Appends the specified number of uninitialized values and returns a pointer to the first of them.
+		T* emplace_n(size_t count)
+		{
+			if (count > static_cast<size_t>(_limit - _end))
+				grow(count);
+			return std::exchange(_end, _end + count);
+		}
+
+		///
+		bool empty() const noexcept { return _end == begin(); }
+
+		///
+		T* end() noexcept { return _end; }
+		const T* end() const noexcept { return _end; }
+
+		///
+		void push_back(const T& value)
+		{
+			if (_end == _limit)
+				grow(1);
+			*_end++ = value;
+		}
+
+		/// Appends a value without checking the capacity, which must have been reserved before.
+		void push_back_unsafe(const T& value) noexcept
+		{
+			assert(_end != _limit);
+			*_end++ = value;
+		}
+
+		/// Moves the values to a buffer without copying them, leaving the vector empty.
+		Buffer release() noexcept
+		{
+			_buffer.resize(size_bytes()); // Doesn't reallocate when shrinking.
+			_end = nullptr;
+			_limit = nullptr;
+			return std::exchange(_buffer, Buffer{});
+		}
+
+		/// Ensures that the vector can hold the specified number of values without reallocation.
+		void reserve(size_t count)
+		{
+			if (count > capacity())
+				grow(count - size());
+		}
+
+		///
+		size_t size() const noexcept { return static_cast<size_t>(_end - begin()); }
+
+		///
+		size_t size_bytes() const noexcept { return size() * sizeof(T); }
+
+		///
+		T& operator[](size_t index) noexcept { return begin()[index]; }
+		const T& operator[](size_t index) const noexcept { return begin()[index]; }
+
+	private:
+		void grow(size_t extra_count)
+		{
+			const auto size = this->size();
+			const auto capacity = this->capacity();
+			// Buffer::reserve preserves only the contents within the buffer size.
+			_buffer.resize(size * sizeof(T));
+			_buffer.reserve((size + (extra_count > capacity ? extra_count : capacity)) * sizeof(T));
+			_end = begin() + size;
+			_limit = begin() + _buffer.capacity() / sizeof(T);
+		}
+
+	private:
+		Buffer _buffer;
+		T* _end = nullptr;
+		T* _limit = nullptr;
+	};
+}
@@ -0,0 +1,78 @@
+// This file is part of the Yttrium toolkit.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <yttrium/base/buffer.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace Yt
+{
+	/// Linear allocator for data that lives for a limited number of frames.
+	/// Allocations bump a pointer, and the memory of a whole frame is freed at once.
+	/// Once the arena has grown enough to hold a frame, further frames make no allocations.
+	class FrameArena
+	{
+	public:
+		/// Maximum number of frames an arena can keep the data for.
+		static constexpr size_t MaxFrames = 3;
+
+		/// Creates an arena which keeps the data allocated during a frame for the specified number of frames.
+		/// More than one frame is needed if the data is read asynchronously after the frame ends.
+		explicit FrameArena(size_t frames = 1) noexcept;
+
+		/// Allocates uninitialized memory which remains valid until the arena finishes the required number of frames.
+		/// The alignment must be a power of two not greater than the memory page size.
+		void* allocate(size_t size, size_t alignment = alignof(std::max_align_t))
+		{
+			const auto offset = (reinterpret_cast<uintptr_t>(_top) + alignment - 1) & ~(alignment - 1);
+			if (!_top || offset > reinterpret_cast<uintptr_t>(_end) || size > reinterpret_cast<uintptr_t>(_end) - offset)
+				return allocate_slow(size, alignment);
+			_top = reinterpret_cast<std::byte*>(offset + size);
+			return reinterpret_cast<void*>(offset);
+		}
+
+		/// Allocates an uninitialized array.
+		template <typename T>
+		T* allocate(size_t count)
+		{
+			static_assert(std::is_trivially_destructible_v<T>);
+			return static_cast<T*>(allocate(count * sizeof(T), alignof(T)));
+		}
+
+		/// Returns the number of bytes of memory allocated for all frames.
+		size_t capacity() const noexcept;
+
+		/// Returns the number of frames finished so far.
+		constexpr uint64_t frame() const noexcept { return _frame; }
+
+		/// Finishes the current frame.
+		/// Memory allocated during the oldest kept frame becomes invalid and is reused for the next frame.
+		void next_frame() noexcept;
+
+		FrameArena(const FrameArena&) = delete;
+		FrameArena& operator=(const FrameArena&) = delete;
+
+	private:
+		void* allocate_slow(size_t size, size_t alignment);
+
+	private:
+		struct Slot
+		{
+			Buffer _buffer;
+			std::vector<Buffer> _overflow; // Blocks allocated when the buffer ran out of space.
+		};
+
+		std::byte* _top = nullptr;
+		std::byte* _end = nullptr;
+		uint64_t _frame = 0;
+		size_t _frames;
+		size_t _slot = 0;
+		Slot _slots[MaxFrames];
+	};
+}
@@ -0,0 +1,51 @@
+// This file is part of the Yttrium toolkit.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <string_view>
+
+namespace Yt
+{
+	/// When a log file sink makes sure the written data reaches the storage device.
+	enum class LogFileSync
+	{
+		Never,    ///< Leave it to the operating system.
+		Rotation, ///< Before a file is rotated or closed.
+		Batch,    ///< After every batch of messages.
+	};
+
+	/// Log file sink settings.
+	struct LogFileOptions
+	{
+		/// Maximum file size in bytes, or zero to disable rotation.
+		/// A file may exceed the limit only if a single batch of messages is larger.
+		uint64_t _max_size = 0;
+
+		/// Number of rotated files to keep (named \c path.1, \c path.2 and so on, from the newest).
+		size_t _max_files = 1;
+
+		///
+		LogFileSync _sync = LogFileSync::Never;
+	};
+
+	/// Receives log messages on the logger thread.
+	class LogSink
+	{
+	public:
+		/// Creates a sink which appends messages to a file, one message per line.
+		/// Returns null if the file can't be opened.
+		static std::unique_ptr<LogSink> open_file(const std::filesystem::path&, const LogFileOptions& = {});
+
+		virtual ~LogSink() noexcept = default;
+
+		/// Writes all messages which have become available since the previous call.
+		/// The messages are valid only until the function returns.
+		virtual void write(std::span<const std::string_view> messages) = 0;
+	};
+}
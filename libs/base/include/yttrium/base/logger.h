@@ -4,35 +4,404 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
 #include <functional>
+#include <limits>
 #include <memory>
 #include <string_view>
+#include <type_traits>
+
+// Minimum level of messages logged with Y_LOG_* macros which are compiled in:
+// 0 (debug), 1 (info), 2 (warning), 3 (error) or 4 (none).
+#ifndef Y_LOG_MIN_LEVEL
+#	define Y_LOG_MIN_LEVEL 0
+#endif
 
 namespace Yt
 {
+	class LogSink;
+
+	/// Log message severity.
+	enum class LogLevel : uint8_t
+	{
+		Debug,
+		Info,
+		Warning,
+		Error,
+	};
+
+	/// Log message source.
+	enum class LogCategory : uint8_t
+	{
+		General,
+		Application,
+		Gui,
+		Renderer,
+		Driver, ///< Graphics driver information and debug messages.
+	};
+
+	/// What to do with a message which doesn't fit into the logger buffer.
+	enum class LogOverflow
+	{
+		DropOldest, ///< Drop the oldest pending messages.
+		DropNewest, ///< Drop the new message.
+		Block,      ///< Wait for the logger thread to free some space, then drop the new message if the timeout expires.
+	};
+
+	/// Logger settings.
+	struct LoggerOptions
+	{
+		/// Logger buffer size in bytes, rounded up to a power of two.
+		size_t _capacity = size_t{ 1 } << 16;
+
+		///
+		LogOverflow _overflow = LogOverflow::DropOldest;
+
+		/// Maximum time to wait for space if the overflow policy is LogOverflow::Block.
+		std::chrono::milliseconds _block_timeout{ 100 };
+	};
+
+	/// Logger buffer usage statistics.
+	struct LoggerStatistics
+	{
+		/// Logger buffer size in bytes.
+		size_t _capacity = 0;
+
+		/// Maximum number of bytes used in the logger buffer at once.
+		size_t _high_water_mark = 0;
+
+		/// Number of messages dropped so far.
+		uint64_t _dropped_messages = 0;
+
+		/// Total size of messages dropped so far.
+		uint64_t _dropped_bytes = 0;
+	};
+
 	/// Asynchronous logger.
 	class Logger
 	{
 	public:
-		/// Maximum message size in bytes.
-		static constexpr size_t MaxMessageSize = 255;
+		/// Maximum size in bytes of the arguments captured by Logger::log.
+		/// Messages with longer arguments are formatted by the calling thread.
+		static constexpr size_t MaxCapturedSize = 1024;
+
+		/// Format string for Logger::log, checked at compile time.
+		/// Supports automatic (\c {}) and manual (\c {0}) argument indexing with optional format specifications.
+		/// Every argument must be used by automatic indexing.
+		template <typename... Args>
+		class Format
+		{
+		public:
+			///
+			template <typename String>
+			requires std::is_convertible_v<const String&, std::string_view>
+			consteval Format(const String& text) // cppcheck-suppress noExplicitConstructor
+				: _text{ text }
+			{
+				if (!check(_text))
+					throw "Invalid log format string";
+			}
+
+			/// Returns true if the format string is valid for the argument types.
+			static constexpr bool check(std::string_view) noexcept;
+
+			///
+			constexpr std::string_view text() const noexcept { return _text; }
+
+		private:
+			std::string_view _text;
+		};
 
 		/// Creates a logger that asynchronously feeds messages into the callback
 		/// or to the standard error stream if no callback is specified.
-		Logger(std::function<void(std::string_view)>&& callback = {});
+		/// If any messages are dropped, the logger reports the number of them in a separate message.
+		Logger(std::function<void(std::string_view)>&& callback = {}, const LoggerOptions& = {});
+
+		/// Creates a logger that asynchronously feeds batches of messages into the sink
+		/// or to the standard error stream if no sink is specified.
+		explicit Logger(std::unique_ptr<LogSink>&&, const LoggerOptions& = {});
 
 		/// Destroys the logger.
 		/// All pending messages are flushed to the output before the destructor finishes.
 		~Logger() noexcept;
 
+		/// Returns true if messages of the specified level are compiled in (see Y_LOG_MIN_LEVEL).
+		static constexpr bool compiled_in(LogLevel level) noexcept { return level >= static_cast<LogLevel>(Y_LOG_MIN_LEVEL); }
+
+		/// Returns true if messages of the specified level and category are enabled at runtime.
+		/// All messages are enabled by default.
+		static bool enabled(LogLevel level, LogCategory category) noexcept
+		{
+			return _filter.load(std::memory_order_relaxed) & filter_bit(level, category);
+		}
+
 		/// Flushes all pending messages to the output.
 		static void flush() noexcept;
 
+		/// Writes a message which is formatted by the logger thread.
+		/// The arguments are captured by value, and strings are copied, so nothing needs to outlive the call.
+		/// Supported arguments are arithmetic and enumeration types, pointers and anything convertible to \c std::string_view.
+		/// If the captured arguments don't fit into MaxCapturedSize bytes, the message is formatted by the calling thread instead.
+		template <typename... Args>
+		static void log(Format<std::type_identity_t<Args>...> format, const Args&... args) noexcept
+		{
+			log(LogCategory::General, format, args...);
+		}
+
+		/// Writes a message of the specified category which is formatted by the logger thread.
+		template <typename... Args>
+		static void log(LogCategory category, Format<std::type_identity_t<Args>...> format, const Args&... args) noexcept
+		{
+			constexpr auto fixed_size = sizeof(std::string_view) + (argument_size<Args>() + ... + 0);
+			static_assert(fixed_size <= MaxCapturedSize, "Too many log arguments");
+			std::array<char, MaxCapturedSize> buffer; // NOLINT(cppcoreguidelines-pro-type-member-init)
+			auto out = store(buffer.data(), format.text());
+			if ((fixed_size + ... + string_argument(args).size()) <= MaxCapturedSize)
+			{
+				((out = capture(out, args)), ...);
+				write_captured(category, { buffer.data(), static_cast<size_t>(out - buffer.data()) });
+			}
+			else
+			{
+				// Strings are referenced rather than copied, so they must be formatted before returning.
+				((out = capture_reference(out, args)), ...);
+				write_formatted(category, { buffer.data(), static_cast<size_t>(out - buffer.data()) });
+			}
+		}
+
+		/// Enables or disables collapsing of consecutive identical messages of the specified category.
+		/// Collapsed repeats are reported as "(last message repeated N times)" when a different message arrives,
+		/// at least once per second while the repeats continue, and when the logger is destroyed.
+		/// Repeats still pending when Logger::flush returns may be reported later. Disabled by default.
+		static void set_collapse_repeats(LogCategory, bool) noexcept;
+
+		/// Enables messages of the specified category and level or higher, and disables the rest.
+		static void set_level(LogCategory, LogLevel) noexcept;
+
+		/// Limits the number of messages of the specified category which each Y_LOG_* statement may write per second.
+		/// Suppressed messages aren't evaluated, and their number is reported when the limit resets.
+		/// Zero means no limit, which is the default.
+		static void set_rate_limit(LogCategory, uint32_t messages_per_second) noexcept;
+
+		/// Returns the buffer usage statistics of the current logger.
+		static LoggerStatistics statistics() noexcept;
+
 		/// Writes a message to the log.
-		/// The size of the message must not exceed MaxMessageSize bytes.
-		static void write(std::string_view) noexcept;
+		/// Messages which don't fit into the logger buffer are truncated.
+		static void write(std::string_view message) noexcept { write(LogCategory::General, message); }
+
+		/// Writes a message of the specified category to the log.
+		static void write(LogCategory, std::string_view) noexcept;
 
 	private:
+		static constexpr uint32_t filter_bit(LogLevel level, LogCategory category) noexcept
+		{
+			return uint32_t{ 1 } << (static_cast<unsigned>(category) * 4 + static_cast<unsigned>(level));
+		}
+
+		enum class ArgumentType : uint8_t
+		{
+			Bool,
+			Char,
+			Int,
+			UInt,
+			Float,
+			Double,
+			Pointer,
+			String,
+			StringReference,
+		};
+
+		template <typename T>
+		static constexpr ArgumentType argument_type() noexcept
+		{
+			if constexpr (std::is_convertible_v<const T&, std::string_view>)
+				return ArgumentType::String;
+			else if constexpr (std::is_same_v<T, bool>)
+				return ArgumentType::Bool;
+			else if constexpr (std::is_same_v<T, char>)
+				return ArgumentType::Char;
+			else if constexpr (std::is_enum_v<T>)
+				return argument_type<std::underlying_type_t<T>>();
+			else if constexpr (std::is_integral_v<T>)
+				return std::is_signed_v<T> ? ArgumentType::Int : ArgumentType::UInt;
+			else if constexpr (std::is_same_v<T, float>)
+				return ArgumentType::Float;
+			else if constexpr (std::is_same_v<T, double>)
+				return ArgumentType::Double;
+			else
+			{
+				static_assert(std::is_pointer_v<T> || std::is_null_pointer_v<T>, "Unsupported log argument type");
+				return ArgumentType::Pointer;
+			}
+		}
+
+		// Size of a captured argument, excluding the string contents.
+		// Strings are counted as references, which are larger than the sizes of copied strings.
+		template <typename T>
+		static constexpr size_t argument_size() noexcept
+		{
+			switch (argument_type<T>())
+			{
+			case ArgumentType::Bool:
+			case ArgumentType::Char: return 2;
+			case ArgumentType::Float: return 1 + sizeof(float);
+			case ArgumentType::String: return 1 + sizeof(std::string_view);
+			default: return 1 + sizeof(uint64_t);
+			}
+		}
+
+		// Returns the string to capture for a string argument, or an empty string for any other argument.
+		template <typename T>
+		static std::string_view string_argument(const T& value) noexcept
+		{
+			if constexpr (argument_type<T>() != ArgumentType::String)
+				return {};
+			else if constexpr (std::is_pointer_v<T>)
+				return value ? std::string_view{ value } : std::string_view{ "" };
+			else
+				return value;
+		}
+
+		template <typename T>
+		static char* capture(char* out, const T& value) noexcept
+		{
+			constexpr auto type = argument_type<T>();
+			*out++ = static_cast<char>(type);
+			if constexpr (type == ArgumentType::String)
+			{
+				const auto text = string_argument(value);
+				out = store(out, static_cast<uint16_t>(text.size()));
+				std::memcpy(out, text.data(), text.size());
+				return out + text.size();
+			}
+			else if constexpr (type == ArgumentType::Bool || type == ArgumentType::Char)
+				return store(out, static_cast<char>(value));
+			else if constexpr (type == ArgumentType::Int)
+				return store(out, static_cast<int64_t>(value));
+			else if constexpr (type == ArgumentType::UInt)
+				return store(out, static_cast<uint64_t>(value));
+			else if constexpr (type == ArgumentType::Float || type == ArgumentType::Double)
+				return store(out, value);
+			else
+				return store(out, static_cast<const void*>(value));
+		}
+
+		template <typename T>
+		static char* capture_reference(char* out, const T& value) noexcept
+		{
+			if constexpr (argument_type<T>() == ArgumentType::String)
+			{
+				*out++ = static_cast<char>(ArgumentType::StringReference);
+				return store(out, string_argument(value));
+			}
+			else
+				return capture(out, value);
+		}
+
+		template <typename T>
+		static char* store(char* out, const T& value) noexcept
+		{
+			std::memcpy(out, &value, sizeof value);
+			return out + sizeof value;
+		}
+
+		static void write_captured(LogCategory, std::string_view) noexcept;
+		static void write_formatted(LogCategory, std::string_view) noexcept;
+
+	private:
+		static inline std::atomic<uint32_t> _filter{ std::numeric_limits<uint32_t>::max() };
+		static inline std::array<std::atomic<uint32_t>, 8> _rate_limits{};
 		const std::unique_ptr<class LoggerPrivate> _private;
+		friend LoggerPrivate;
+		friend class LogCallSite;
+	};
+
+	/// Rate limiting state of a logging statement, see Logger::set_rate_limit.
+	class LogCallSite
+	{
+	public:
+		constexpr LogCallSite() noexcept = default;
+
+		/// Returns true if the statement may write a message of the specified category now.
+		bool allow(LogCategory category) noexcept
+		{
+			const auto limit = Logger::_rate_limits[static_cast<size_t>(category)].load(std::memory_order_relaxed);
+			return !limit || allow_limited(category, limit);
+		}
+
+	private:
+		bool allow_limited(LogCategory, uint32_t limit) noexcept;
+
+	private:
+		std::atomic<int64_t> _window_start{ std::numeric_limits<int64_t>::min() / 2 };
+		std::atomic<uint32_t> _count{ 0 };
+		std::atomic<uint32_t> _suppressed{ 0 };
 	};
+
+	template <typename... Args>
+	constexpr bool Logger::Format<Args...>::check(std::string_view text) noexcept
+	{
+		constexpr auto argument_count = sizeof...(Args);
+		size_t automatic = 0;
+		bool manual = false;
+		for (size_t i = 0; i < text.size(); ++i)
+		{
+			if (text[i] == '}')
+			{
+				if (++i == text.size() || text[i] != '}')
+					return false;
+				continue;
+			}
+			if (text[i] != '{')
+				continue;
+			if (++i == text.size())
+				return false;
+			if (text[i] == '{')
+				continue;
+			if (text[i] >= '0' && text[i] <= '9')
+			{
+				size_t index = 0;
+				for (; i < text.size() && text[i] >= '0' && text[i] <= '9'; ++i)
+					index = index * 10 + static_cast<size_t>(text[i] - '0');
+				if (index >= argument_count)
+					return false;
+				manual = true;
+			}
+			else if (automatic++ == argument_count)
+				return false;
+			if (i < text.size() && text[i] == ':')
+				while (++i < text.size() && text[i] != '}')
+					if (text[i] == '{')
+						return false; // Nested replacement fields aren't supported.
+			if (i == text.size() || text[i] != '}')
+				return false;
+		}
+		return manual ? automatic == 0 : automatic == argument_count;
+	}
 }
+
+/// Logs a formatted message if its level is compiled in and enabled at runtime
+/// and the statement hasn't exceeded the rate limit of the category.
+/// The arguments aren't evaluated if the message is disabled.
+#define Y_LOG(level, category, ...) \
+	do \
+	{ \
+		if constexpr (::Yt::Logger::compiled_in(::Yt::LogLevel::level)) \
+			if (::Yt::Logger::enabled(::Yt::LogLevel::level, ::Yt::LogCategory::category)) \
+			{ \
+				static ::Yt::LogCallSite y_log_call_site; \
+				if (y_log_call_site.allow(::Yt::LogCategory::category)) \
+					::Yt::Logger::log(::Yt::LogCategory::category, __VA_ARGS__); \
+			} \
+	} while (false)
+
+#define Y_LOG_DEBUG(category, ...) Y_LOG(Debug, category, __VA_ARGS__)
+#define Y_LOG_INFO(category, ...) Y_LOG(Info, category, __VA_ARGS__)
+#define Y_LOG_WARNING(category, ...) Y_LOG(Warning, category, __VA_ARGS__)
+#define Y_LOG_ERROR(category, ...) Y_LOG(Error, category, __VA_ARGS__)
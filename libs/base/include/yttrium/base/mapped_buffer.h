@@ -0,0 +1,65 @@
+// This file is part of the Yttrium toolkit.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <yttrium/base/flags.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <utility>
+
+namespace Yt
+{
+	/// Read-only memory mapping of a file.
+	/// The file contents are paged in on demand, so the data is accessible without being copied to a Buffer.
+	class MappedBuffer
+	{
+	public:
+		/// Memory access hints.
+		enum class Hint
+		{
+			Sequential = 1 << 0, ///< The data is going to be read sequentially, so it can be read ahead aggressively.
+			WillNeed = 1 << 1,   ///< The data is going to be needed soon, so reading it can start in the background.
+		};
+
+		/// Maps the specified file into memory.
+		/// Returns an empty optional if the file can't be opened or mapped.
+		static std::optional<MappedBuffer> open(const std::filesystem::path&, Flags<Hint> = {}) noexcept;
+
+		///
+		MappedBuffer() noexcept = default;
+
+		///
+		MappedBuffer(MappedBuffer&& other) noexcept
+			: _data{ std::exchange(other._data, nullptr) }, _size{ std::exchange(other._size, 0) } {}
+
+		///
+		~MappedBuffer() noexcept;
+
+		///
+		MappedBuffer& operator=(MappedBuffer&&) noexcept;
+
+		/// Applies the hints to the mapped memory.
+		void advise(Flags<Hint>) const noexcept;
+
+		///
+		constexpr const uint8_t* begin() const noexcept { return static_cast<const uint8_t*>(_data); }
+
+		///
+		constexpr const void* data() const noexcept { return _data; }
+
+		///
+		constexpr const uint8_t* end() const noexcept { return static_cast<const uint8_t*>(_data) + _size; }
+
+		///
+		constexpr size_t size() const noexcept { return _size; }
+
+	private:
+		const void* _data = nullptr;
+		size_t _size = 0;
+	};
+}
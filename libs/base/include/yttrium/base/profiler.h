@@ -0,0 +1,100 @@
+// This file is part of the Yttrium toolkit.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+// Whether Y_PROFILE_SCOPE statements are compiled in: 1 (yes) or 0 (no).
+#ifndef Y_PROFILER
+#	define Y_PROFILER 1
+#endif
+
+namespace Yt
+{
+	/// CPU profiler which records the time spent in scopes marked with ProfileScope.
+	/// Each thread records into its own fixed-size ring, so only the latest events are kept.
+	/// When a thread exits, its events are kept and its ring is reused by the next thread.
+	class Profiler
+	{
+	public:
+		/// Maximum number of events kept for each thread.
+		static constexpr size_t MaxThreadEvents = (size_t{ 1 } << 16) - 1;
+
+		/// Discards all recorded events.
+		static void clear() noexcept;
+
+		/// Returns true if profiling is enabled. Profiling is disabled by default.
+		static bool enabled() noexcept { return _enabled.load(std::memory_order_relaxed); }
+
+		/// Returns the current profiler time in nanoseconds.
+		static int64_t now() noexcept { return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count(); }
+
+		/// Enables or disables profiling.
+		/// Scopes which were entered while profiling was enabled are recorded even if it is disabled before they exit.
+		static void set_enabled(bool) noexcept;
+
+		/// Sets the name of the current thread in the trace.
+		/// The name must remain valid until the recorded events are no longer needed.
+		static void set_thread_name(const char*) noexcept;
+
+		/// Returns the recorded events in Chrome trace event format,
+		/// which can be viewed with \c chrome://tracing or the Perfetto UI.
+		/// Recording may continue while the trace is being built.
+		static std::string trace();
+
+		/// Writes the trace to a file. Returns false if the file can't be written.
+		static bool write_trace(const std::filesystem::path&);
+
+	private:
+		static void record(const char* name, int64_t start) noexcept;
+
+	private:
+		static inline std::atomic<bool> _enabled{ false };
+		friend class ProfileScope;
+	};
+
+	/// Records the time between its construction and destruction if profiling is enabled.
+	/// A disabled scope costs a relaxed load and a predictable branch.
+	class ProfileScope
+	{
+	public:
+		/// The name must remain valid until the recorded events are no longer needed.
+		explicit ProfileScope(const char* name) noexcept
+		{
+			if (Profiler::enabled()) [[unlikely]]
+			{
+				_name = name;
+				_start = Profiler::now();
+			}
+		}
+
+		~ProfileScope() noexcept
+		{
+			if (_name) [[unlikely]]
+				Profiler::record(_name, _start);
+		}
+
+		ProfileScope(const ProfileScope&) = delete;
+		ProfileScope& operator=(const ProfileScope&) = delete;
+
+	private:
+		const char* _name = nullptr;
+		int64_t _start = 0;
+	};
+}
+
+#define Y_PROFILE_CONCATENATE_(a, b) a##b
+#define Y_PROFILE_CONCATENATE(a, b) Y_PROFILE_CONCATENATE_(a, b)
+
+/// Profiles the rest of the enclosing scope under the specified name if Y_PROFILER is nonzero.
+#if Y_PROFILER
+#	define Y_PROFILE_SCOPE(name) const ::Yt::ProfileScope Y_PROFILE_CONCATENATE(y_profile_scope_, __LINE__)(name)
+#else
+#	define Y_PROFILE_SCOPE(name) static_cast<void>(0)
+#endif
@@ -0,0 +1,78 @@
+// This file is part of the Yttrium toolkit.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace Yt
+{
+	class Buffer;
+	class MappedBuffer;
+
+	/// Immutable data shared by reference counting.
+	/// Copying a SharedBuffer or taking a slice of it doesn't copy the data,
+	/// and the data is freed when the last SharedBuffer referencing it is destroyed.
+	class SharedBuffer
+	{
+	public:
+		/// Creates a buffer with no data.
+		constexpr SharedBuffer() noexcept = default;
+
+		/// Takes ownership of the Buffer contents without copying them.
+		explicit SharedBuffer(Buffer&&);
+
+		/// Takes ownership of the file mapping.
+		explicit SharedBuffer(MappedBuffer&&);
+
+		///
+		SharedBuffer(const SharedBuffer& other) noexcept
+			: _storage{ other._storage }, _data{ other._data }, _size{ other._size } { acquire(); }
+
+		///
+		SharedBuffer(SharedBuffer&& other) noexcept
+			: _storage{ std::exchange(other._storage, nullptr) }, _data{ std::exchange(other._data, nullptr) }, _size{ std::exchange(other._size, 0) } {}
+
+		///
+		~SharedBuffer() noexcept { release(); }
+
+		///
+		SharedBuffer& operator=(const SharedBuffer&) noexcept;
+
+		///
+		SharedBuffer& operator=(SharedBuffer&&) noexcept;
+
+		///
+		constexpr const uint8_t* begin() const noexcept { return static_cast<const uint8_t*>(_data); }
+
+		///
+		constexpr const void* data() const noexcept { return _data; }
+
+		///
+		constexpr const uint8_t* end() const noexcept { return static_cast<const uint8_t*>(_data) + _size; }
+
+		///
+		constexpr size_t size() const noexcept { return _size; }
+
+		/// Returns a buffer referencing a part of the data.
+		/// The part is clamped to the data boundaries like std::string_view::substr does.
+		SharedBuffer slice(size_t offset, size_t size = SIZE_MAX) const noexcept;
+
+		/// Returns the number of SharedBuffers referencing the data.
+		size_t use_count() const noexcept;
+
+	private:
+		struct Storage;
+
+		void acquire() const noexcept;
+		void release() noexcept;
+
+	private:
+		Storage* _storage = nullptr;
+		const void* _data = nullptr;
+		size_t _size = 0;
+	};
+}
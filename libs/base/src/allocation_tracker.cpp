@@ -0,0 +1,165 @@
+// This file is part of the Yttrium toolkit.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <yttrium/base/allocation_tracker.h>
+
+#include <yttrium/base/logger.h>
+#include "allocation_tracker.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#ifndef Y_TRACK_NEW
+#	define Y_TRACK_NEW 0
+#endif
+
+namespace
+{
+	struct ThreadState
+	{
+		Yt::AllocationCounters _counters;
+		size_t _no_allocation_scopes = 0;
+	};
+
+	thread_local ThreadState _thread_state;                                        // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+	std::atomic<Yt::NoAllocationPolicy> _policy{ Yt::NoAllocationPolicy::Report }; // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+	// Called after the allocation is counted.
+	void check_allocation(const char* kind) noexcept
+	{
+		if (_thread_state._no_allocation_scopes > 0 && _policy.load(std::memory_order_relaxed) == Yt::NoAllocationPolicy::Abort)
+		{
+			std::fprintf(stderr, "%s allocation in a no-allocation scope\n", kind);
+			std::abort();
+		}
+	}
+}
+
+namespace Yt
+{
+	void count_buffer_allocation() noexcept
+	{
+		++_thread_state._counters._buffer_allocations;
+		::check_allocation("Buffer");
+	}
+
+	AllocationCounters AllocationTracker::counters() noexcept
+	{
+		return _thread_state._counters;
+	}
+
+	void AllocationTracker::set_no_allocation_policy(NoAllocationPolicy policy) noexcept
+	{
+		_policy.store(policy, std::memory_order_relaxed);
+	}
+
+	bool AllocationTracker::tracks_new() noexcept
+	{
+		return Y_TRACK_NEW;
+	}
+
+	NoAllocationScope::NoAllocationScope(const char* name) noexcept
+		: _name{ name }
+		, _start{ _thread_state._counters }
+	{
+		++_thread_state._no_allocation_scopes;
+	}
+
+	NoAllocationScope::~NoAllocationScope() noexcept
+	{
+		--_thread_state._no_allocation_scopes;
+		if (_policy.load(std::memory_order_relaxed) == NoAllocationPolicy::Report)
+			if (const auto count = allocations())
+				Y_LOG_WARNING(General, "{} allocations in no-allocation scope \"{}\"", count, _name);
+	}
+
+	uint64_t NoAllocationScope::allocations() const noexcept
+	{
+		const auto& counters = _thread_state._counters;
+		return counters._buffer_allocations - _start._buffer_allocations + counters._heap_allocations - _start._heap_allocations;
+	}
+}
+
+#if Y_TRACK_NEW
+
+#	ifdef _WIN32
+#		include <malloc.h>
+#	endif
+
+namespace
+{
+	void* allocate(size_t size) noexcept
+	{
+		++_thread_state._counters._heap_allocations;
+		::check_allocation("Heap");
+		return std::malloc(size > 0 ? size : 1);
+	}
+
+	void* allocate(size_t size, std::align_val_t alignment) noexcept
+	{
+		++_thread_state._counters._heap_allocations;
+		::check_allocation("Heap");
+		const auto alignment_value = static_cast<size_t>(alignment);
+#	ifdef _WIN32
+		return ::_aligned_malloc(size > 0 ? size : 1, alignment_value);
+#	else
+		return std::aligned_alloc(alignment_value, size > 0 ? (size + alignment_value - 1) & ~(alignment_value - 1) : alignment_value);
+#	endif
+	}
+
+	void deallocate(void* data) noexcept
+	{
+		std::free(data);
+	}
+
+	void deallocate(void* data, std::align_val_t) noexcept
+	{
+#	ifdef _WIN32
+		::_aligned_free(data);
+#	else
+		std::free(data);
+#	endif
+	}
+
+	template <typename... Alignment>
+	void* allocate_or_throw(size_t size, Alignment... alignment)
+	{
+		for (;;)
+		{
+			if (const auto data = ::allocate(size, alignment...))
+				return data;
+			const auto handler = std::get_new_handler();
+			if (!handler)
+				throw std::bad_alloc{};
+			handler();
+		}
+	}
+}
+
+// NOLINTBEGIN(cert-dcl54-cpp, hicpp-new-delete-operators, misc-new-delete-overloads)
+void* operator new(size_t size) { return ::allocate_or_throw(size); }
+void* operator new[](size_t size) { return ::allocate_or_throw(size); }
+void* operator new(size_t size, std::align_val_t alignment) { return ::allocate_or_throw(size, alignment); }
+void* operator new[](size_t size, std::align_val_t alignment) { return ::allocate_or_throw(size, alignment); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return ::allocate(size); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return ::allocate(size); }
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return ::allocate(size, alignment); }
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return ::allocate(size, alignment); }
+void operator delete(void* data) noexcept { ::deallocate(data); }
+void operator delete[](void* data) noexcept { ::deallocate(data); }
+void operator delete(void* data, size_t) noexcept { ::deallocate(data); }
+void operator delete[](void* data, size_t) noexcept { ::deallocate(data); }
+void operator delete(void* data, std::align_val_t alignment) noexcept { ::deallocate(data, alignment); }
+void operator delete[](void* data, std::align_val_t alignment) noexcept { ::deallocate(data, alignment); }
+void operator delete(void* data, size_t, std::align_val_t alignment) noexcept { ::deallocate(data, alignment); }
+void operator delete[](void* data, size_t, std::align_val_t alignment) noexcept { ::deallocate(data, alignment); }
+void operator delete(void* data, const std::nothrow_t&) noexcept { ::deallocate(data); }
+void operator delete[](void* data, const std::nothrow_t&) noexcept { ::deallocate(data); }
+void operator delete(void* data, std::align_val_t alignment, const std::nothrow_t&) noexcept { ::deallocate(data, alignment); }
+void operator delete[](void* data, std::align_val_t alignment, const std::nothrow_t&) noexcept { ::deallocate(data, alignment); }
+// NOLINTEND(cert-dcl54-cpp, hicpp-new-delete-operators, misc-new-delete-overloads)
+
+#endif
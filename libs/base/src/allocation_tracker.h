@@ -0,0 +1,11 @@
+// This file is part of the Yttrium toolkit.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+namespace Yt
+{
+	// Counts a buffer memory allocation made by the current thread.
+	void count_buffer_allocation() noexcept;
+}
@@ -4,8 +4,10 @@
 
 #include <yttrium/base/buffer.h>
 
+#include "allocation_tracker.h"
 #include "buffer_memory.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 #include <new>
@@ -19,6 +21,18 @@ namespace Yt
 	{
 		if (!_data && _capacity > 0)
 			throw std::bad_alloc{};
+		if (_data)
+			count_buffer_allocation();
+	}
+
+	Buffer::Buffer(size_t size, PageAligned)
+		: _size{ size }
+		, _capacity{ BufferMemory::capacity_for_size(std::max(_size, BufferMemory::granularity())) }
+		, _data{ _buffer_memory.allocate(_capacity) }
+	{
+		if (!_data)
+			throw std::bad_alloc{};
+		count_buffer_allocation();
 	}
 
 	Buffer::Buffer(size_t size, const void* data)
@@ -34,6 +48,25 @@ namespace Yt
 			throw std::bad_alloc{};
 	}
 
+	void Buffer::reserve_address_space(size_t capacity)
+	{
+		const auto granularity_mask = BufferMemory::granularity() - 1;
+		const auto reserved = (capacity + granularity_mask) & ~granularity_mask;
+		if (reserved <= _capacity || reserved <= _reserved)
+			return;
+		const auto committed = (_size + granularity_mask) & ~granularity_mask;
+		const auto data = _buffer_memory.reserve(reserved, committed, _hints);
+		if (!data)
+			throw std::bad_alloc{};
+		count_buffer_allocation();
+		if (_size > 0)
+			std::memcpy(data, _data, _size);
+		deallocate();
+		_capacity = committed;
+		_data = data;
+		_reserved = reserved;
+	}
+
 	void Buffer::reset(size_t size)
 	{
 		if (!try_grow(size, 0, true))
@@ -51,50 +84,109 @@ namespace Yt
 		if (allocate_bytes > _capacity)
 		{
 			assert(allocate_bytes >= copy_bytes);
-			const auto new_capacity = BufferMemory::capacity_for_size(allocate_bytes);
-			const auto new_data = _data
-				? _buffer_memory.reallocate(_data, _capacity, new_capacity, copy_bytes)
-				: _buffer_memory.allocate(new_capacity);
-			if (!new_data)
-				return false;
-			_capacity = new_capacity;
-			_data = new_data;
+			if (allocate_bytes <= _reserved)
+			{
+				// Committing the reserved memory in bigger steps saves system calls.
+				const auto granularity_mask = BufferMemory::granularity() - 1;
+				const auto new_capacity = std::min(_reserved, std::max((allocate_bytes + granularity_mask) & ~granularity_mask, 2 * _capacity));
+				if (!_buffer_memory.commit(_data, _capacity, new_capacity, _hints))
+					return false;
+				count_buffer_allocation();
+				_capacity = new_capacity;
+			}
+			else
+			{
+				const auto new_capacity = BufferMemory::capacity_for_size(allocate_bytes);
+				const auto new_data = _data && !_reserved
+					? _buffer_memory.reallocate(_data, _capacity, new_capacity, copy_bytes, _hints)
+					: _buffer_memory.allocate(new_capacity, _hints);
+				if (!new_data)
+					return false;
+				count_buffer_allocation();
+				if (_reserved)
+				{
+					if (copy_bytes > 0)
+						std::memcpy(new_data, _data, copy_bytes);
+					_buffer_memory.release(_data, _capacity, _reserved);
+					_reserved = 0;
+				}
+				_capacity = new_capacity;
+				_data = new_data;
+			}
 		}
 		if (do_resize)
 			_size = allocate_bytes;
 		return true;
 	}
 
+	void Buffer::set_hints(Flags<Hint> hints) noexcept
+	{
+		_hints = hints;
+		if (_reserved)
+			_buffer_memory.advise(_data, _capacity, _reserved, hints);
+		else if (_data)
+			_buffer_memory.advise(_data, _capacity, hints);
+	}
+
 	size_t Buffer::memory_granularity() noexcept
 	{
 		return BufferMemory::granularity();
 	}
 
+	BufferStatistics Buffer::memory_statistics() noexcept
+	{
+		return _buffer_memory.statistics();
+	}
+
+	void Buffer::set_retained_memory(size_t bytes) noexcept
+	{
+		_buffer_memory.set_trim_threshold(BufferMemory::TrimPolicy::Release, bytes);
+	}
+
+	size_t Buffer::trim_memory() noexcept
+	{
+		return _buffer_memory.trim(BufferMemory::TrimPolicy::Release);
+	}
+
 	Buffer::Buffer(Buffer&& other) noexcept
 		: _size(other._size)
 		, _capacity(other._capacity)
 		, _data(other._data)
+		, _reserved(other._reserved)
+		, _hints(other._hints)
 	{
 		other._data = nullptr;
+		other._reserved = 0;
 	}
 
 	Buffer::~Buffer() noexcept
 	{
-		if (_data)
-			_buffer_memory.deallocate(_data, _capacity);
+		deallocate();
 	}
 
 	Buffer& Buffer::operator=(Buffer&& other) noexcept
 	{
-		if (_data)
-			_buffer_memory.deallocate(_data, _capacity);
+		deallocate();
 		_size = other._size;
 		_capacity = other._capacity;
 		_data = other._data;
+		_reserved = other._reserved;
+		_hints = other._hints;
 		other._data = nullptr;
+		other._reserved = 0;
 		return *this;
 	}
 
+	void Buffer::deallocate() noexcept
+	{
+		if (!_data)
+			return;
+		if (_reserved)
+			_buffer_memory.release(_data, _capacity, _reserved);
+		else
+			_buffer_memory.deallocate(_data, _capacity);
+	}
+
 	bool operator==(const Buffer& a, const Buffer& b) noexcept
 	{
 		return a.size() == b.size() && (a.size() == 0 || !std::memcmp(a.data(), b.data(), a.size()));
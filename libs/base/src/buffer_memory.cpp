@@ -8,13 +8,18 @@
 
 #include <seir_base/int_utils.hpp>
 
+#include <algorithm>
+#include <bitset>
 #include <cassert>
 #include <cstddef>
 #include <cstring>
+#include <functional>
+#include <iterator>
+#include <type_traits>
 
 namespace
 {
-	size_t level_from_capacity(size_t capacity) noexcept
+	constexpr size_t level_from_capacity(size_t capacity) noexcept
 	{
 		assert(seir::isPowerOf2(capacity));
 		size_t level = 0;
@@ -28,43 +33,290 @@ namespace
 	{
 		void* _next;
 	};
+
+	// Free blocks in the shared pool are doubly linked so that
+	// a block can be removed from its list when its buddy is freed.
+	struct FreeBlock
+	{
+		void* _next;
+		void* _prev;
+	};
+
+	void link_block(void*& list, void* block) noexcept
+	{
+		static_cast<FreeBlock*>(block)->_next = list;
+		static_cast<FreeBlock*>(block)->_prev = nullptr;
+		if (list)
+			static_cast<FreeBlock*>(list)->_prev = block;
+		list = block;
+	}
+
+	// Writes to every page of a range without changing its contents
+	// to make the operating system back the range with physical memory.
+	void touch_pages(void* data, size_t size, size_t page_size) noexcept
+	{
+		const auto bytes = static_cast<volatile std::byte*>(data);
+		for (size_t offset = 0; offset < size; offset += page_size)
+			bytes[offset] = bytes[offset];
+		if (size > 0)
+			bytes[size - 1] = bytes[size - 1];
+	}
+
+	// Applies hints to memory allocated directly from the operating system.
+	void apply_hints(void* data, size_t size, Yt::Flags<Yt::Buffer::Hint> hints) noexcept
+	{
+		if (hints & Yt::Buffer::Hint::HugePages)
+			Yt::vm_use_huge_pages(data, size);
+		if (hints & Yt::Buffer::Hint::Lock && Yt::vm_lock(data, size))
+			return; // Locked pages are populated.
+		if (hints & Yt::Buffer::Hint::Populate && !Yt::vm_populate(data, size))
+			::touch_pages(data, size, Yt::BufferMemory::granularity());
+	}
+
+	// Increments a counter which is written by a single thread, avoiding an atomic read-modify-write.
+	void increment(std::atomic<size_t>& counter) noexcept
+	{
+		counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+	}
+
+	void unlink_block(void*& list, void* block) noexcept
+	{
+		const auto next = static_cast<FreeBlock*>(block)->_next;
+		const auto prev = static_cast<FreeBlock*>(block)->_prev;
+		if (prev)
+			static_cast<FreeBlock*>(prev)->_next = next;
+		else
+		{
+			assert(list == block);
+			list = next;
+		}
+		if (next)
+			static_cast<FreeBlock*>(next)->_prev = prev;
+	}
 }
 
 namespace Yt
 {
-	void* BufferMemory::allocate(size_t capacity) noexcept
+	struct BufferMemory::Chunk
 	{
-		assert(capacity > 0 && capacity == capacity_for_size(capacity));
-		if (capacity > MaxSmallBlockSize)
-			return vm_allocate(capacity);
-		const auto matching_level = ::level_from_capacity(capacity);
-		std::scoped_lock lock{ _small_blocks_mutex };
-		if (const auto matching_block = _small_blocks[matching_level])
+		std::byte* _base;
+		bool _decommitted; // Decommitted chunks are free, but aren't in the free lists, which are stored in the blocks.
+		std::bitset<2 << (ChunkLevel - MinSmallBlockLevel)> _free; // Indexed by buddy tree nodes, the whole chunk being node 1.
+
+		// Chunks are stored in virtual memory and moved using memmove.
+		static_assert(std::is_trivially_copyable_v<decltype(_free)>);
+
+		bool is_free(const std::byte* block, size_t level) const noexcept { return _free[node(block, level)]; }
+		void set_free(const std::byte* block, size_t level, bool free) noexcept { _free[node(block, level)] = free; }
+
+	private:
+		size_t node(const std::byte* block, size_t level) const noexcept
+		{
+			assert(level >= MinSmallBlockLevel && level <= ChunkLevel);
+			assert(block >= _base && block < _base + ChunkSize);
+			return (ChunkSize >> level) + (static_cast<size_t>(block - _base) >> level);
+		}
+	};
+
+	// Small block free lists owned by a single thread.
+	// Allocations and deallocations of cached sizes use the shared pool
+	// only when a list runs out of blocks or accumulates too many of them.
+	// Only the global BufferMemory instance uses thread caches.
+	class BufferCache
+	{
+	public:
+		BufferCache() noexcept
 		{
-			_small_blocks[matching_level] = static_cast<Block*>(matching_block)->_next;
-			return matching_block;
+			std::scoped_lock lock{ _buffer_memory._small_blocks_mutex };
+			_next = _buffer_memory._caches;
+			if (_next)
+				_next->_prev = this;
+			_buffer_memory._caches = this;
 		}
-		auto block_level = matching_level + 1;
-		void* block = nullptr;
-		for (; block_level <= MaxSmallBlockLevel; ++block_level)
+
+		~BufferCache() noexcept
 		{
-			if (block = _small_blocks[block_level]; block)
+			flush();
+			_active = false;
+			std::scoped_lock lock{ _buffer_memory._small_blocks_mutex };
+			for (size_t level = 0; level < std::size(_lists); ++level)
 			{
-				_small_blocks[block_level] = static_cast<Block*>(block)->_next;
-				break;
+				_buffer_memory._level_counters[level]._allocations += _lists[level]._allocations.load(std::memory_order_relaxed);
+				_buffer_memory._level_counters[level]._deallocations += _lists[level]._deallocations.load(std::memory_order_relaxed);
+			}
+			if (_prev)
+				_prev->_next = _next;
+			else
+				_buffer_memory._caches = _next;
+			if (_next)
+				_next->_prev = _prev;
+		}
+
+		[[nodiscard]] constexpr bool active() const noexcept { return _active; }
+		[[nodiscard]] constexpr const BufferCache* next() const noexcept { return _next; }
+
+		void* allocate(size_t level) noexcept
+		{
+			assert(level < std::size(_lists));
+			auto& list = _lists[level];
+			auto count = list._count.load(std::memory_order_relaxed);
+			if (!list._head)
+			{
+				count = _buffer_memory.allocate_blocks(level, batch_count(level), list._head);
+				if (!list._head)
+					return nullptr;
+			}
+			const auto block = list._head;
+			list._head = static_cast<Block*>(block)->_next;
+			list._count.store(count - 1, std::memory_order_relaxed);
+			::increment(list._allocations);
+			return block;
+		}
+
+		void deallocate(void* block, size_t level) noexcept
+		{
+			assert(level < std::size(_lists));
+			auto& list = _lists[level];
+			static_cast<Block*>(block)->_next = list._head;
+			list._head = block;
+			::increment(list._deallocations);
+			if (const auto count = list._count.load(std::memory_order_relaxed) + 1; count <= 2 * batch_count(level))
+			{
+				list._count.store(count, std::memory_order_relaxed);
+				return;
+			}
+			// The most recently freed blocks are more likely to be in the CPU cache, so we keep them.
+			auto last_kept = list._head;
+			for (auto i = batch_count(level); i > 1; --i)
+				last_kept = static_cast<Block*>(last_kept)->_next;
+			const auto first_released = static_cast<Block*>(last_kept)->_next;
+			static_cast<Block*>(last_kept)->_next = nullptr;
+			auto last_released = first_released;
+			while (const auto next = static_cast<Block*>(last_released)->_next)
+				last_released = next;
+			_buffer_memory.deallocate_blocks(level, first_released, last_released);
+			list._count.store(batch_count(level), std::memory_order_relaxed);
+		}
+
+		void flush() noexcept
+		{
+			for (size_t level = 0; level < std::size(_lists); ++level)
+			{
+				if (auto& list = _lists[level]; list._head)
+				{
+					auto last = list._head;
+					while (const auto next = static_cast<Block*>(last)->_next)
+						last = next;
+					_buffer_memory.deallocate_blocks(level, list._head, last);
+					list._head = nullptr;
+					list._count.store(0, std::memory_order_relaxed);
+				}
+			}
+		}
+
+		// Called from any thread with the BufferMemory mutex locked.
+		void update_statistics(BufferStatistics& statistics) const noexcept
+		{
+			for (size_t level = 0; level < std::size(_lists); ++level)
+			{
+				auto& counters = statistics._levels[level];
+				counters._allocations += _lists[level]._allocations.load(std::memory_order_relaxed);
+				counters._deallocations += _lists[level]._deallocations.load(std::memory_order_relaxed);
+				counters._cached_bytes += _lists[level]._count.load(std::memory_order_relaxed) << level;
 			}
 		}
-		if (!block)
-			if (block = vm_allocate(2 * MaxSmallBlockSize); !block) // TODO: Try merging smaller blocks before allocating a new big one.
+
+		BufferCache(const BufferCache&) = delete;
+		BufferCache& operator=(const BufferCache&) = delete;
+
+	private:
+		static constexpr size_t batch_count(size_t level) noexcept
+		{
+			return BufferMemory::CacheBatchSize >> level;
+		}
+
+	private:
+		// Counters are written only by the owning thread, but may be read by any thread.
+		struct List
+		{
+			void* _head = nullptr;
+			std::atomic<size_t> _count{ 0 };
+			std::atomic<size_t> _allocations{ 0 };
+			std::atomic<size_t> _deallocations{ 0 };
+		};
+
+		List _lists[::level_from_capacity(BufferMemory::MaxCachedBlockSize) + 1]{};
+		bool _active = true;
+		BufferCache* _prev = nullptr;
+		BufferCache* _next = nullptr;
+	};
+
+	thread_local BufferCache _buffer_cache;
+
+	void BufferMemory::advise(void* data, size_t capacity, Flags<Buffer::Hint> hints) noexcept
+	{
+		assert(data);
+		if (capacity <= MaxSmallBlockSize)
+		{
+			// Small blocks share pages with other blocks.
+			if (hints & Buffer::Hint::Populate)
+				::touch_pages(data, capacity, granularity());
+			return;
+		}
+		::apply_hints(data, capacity, hints);
+	}
+
+	void BufferMemory::advise(void* data, size_t capacity, size_t reserved_capacity, Flags<Buffer::Hint> hints) noexcept
+	{
+		assert(data && capacity <= reserved_capacity);
+		// Reserved address space belongs to a single buffer regardless of how much of it is committed,
+		// but only the committed part may be accessed.
+		if (hints & Buffer::Hint::HugePages)
+			vm_use_huge_pages(data, reserved_capacity);
+		if (capacity > 0 && hints != Flags<Buffer::Hint>{})
+			::apply_hints(data, capacity, hints);
+	}
+
+	void* BufferMemory::allocate(size_t capacity, Flags<Buffer::Hint> hints) noexcept
+	{
+		assert(capacity > 0 && capacity == capacity_for_size(capacity));
+		void* data = nullptr;
+		if (capacity > MaxSmallBlockSize)
+		{
+			data = hints & Buffer::Hint::HugePages && capacity >= HugePageSize
+				? vm_allocate_aligned(capacity, HugePageSize)
+				: vm_allocate(capacity);
+			if (!data)
 				return nullptr;
-		do
+			_large_allocations.fetch_add(1, std::memory_order_relaxed);
+			_large_bytes.fetch_add(capacity, std::memory_order_relaxed);
+			add_mapped_bytes(capacity);
+		}
+		else if (const auto level = ::level_from_capacity(capacity); capacity <= MaxCachedBlockSize && this == &_buffer_memory && _buffer_cache.active())
+			data = _buffer_cache.allocate(level);
+		else
 		{
-			--block_level;
-			static_cast<Block*>(block)->_next = _small_blocks[block_level];
-			_small_blocks[block_level] = block;
-			block = static_cast<std::byte*>(block) + (size_t{ 1 } << block_level);
-		} while (block_level > matching_level);
-		return block;
+			std::scoped_lock lock{ _small_blocks_mutex };
+			data = allocate_block(level);
+			if (data)
+				++_level_counters[level]._allocations;
+		}
+		if (data && hints != Flags<Buffer::Hint>{})
+			advise(data, capacity, hints);
+		return data;
+	}
+
+	bool BufferMemory::commit(void* data, size_t old_capacity, size_t new_capacity, Flags<Buffer::Hint> hints) noexcept
+	{
+		assert(old_capacity < new_capacity);
+		const auto committed_data = static_cast<std::byte*>(data) + old_capacity;
+		if (!vm_commit(committed_data, new_capacity - old_capacity))
+			return false;
+		if (hints != Flags<Buffer::Hint>{})
+			::apply_hints(committed_data, new_capacity - old_capacity, hints);
+		_large_bytes.fetch_add(new_capacity - old_capacity, std::memory_order_relaxed);
+		add_mapped_bytes(new_capacity - old_capacity);
+		return true;
 	}
 
 	void BufferMemory::deallocate(void* data, size_t capacity) noexcept
@@ -72,22 +324,55 @@ namespace Yt
 		assert(data);
 		assert(capacity > 0 && capacity == capacity_for_size(capacity));
 		if (capacity > MaxSmallBlockSize)
-			return vm_deallocate(data, capacity);
+			return release(data, capacity, capacity);
 		const auto level = ::level_from_capacity(capacity);
+		if (capacity <= MaxCachedBlockSize && this == &_buffer_memory && _buffer_cache.active())
+			return _buffer_cache.deallocate(data, level);
+		std::scoped_lock lock{ _small_blocks_mutex };
+		++_level_counters[level]._deallocations;
+		deallocate_block(data, level);
+	}
+
+	BufferMemory::FragmentationCounters BufferMemory::fragmentation_counters() noexcept
+	{
 		std::scoped_lock lock{ _small_blocks_mutex };
-		static_cast<Block*>(data)->_next = _small_blocks[level];
-		_small_blocks[level] = data;
+		return _counters;
 	}
 
-	void* BufferMemory::reallocate(void* old_data, size_t old_capacity, size_t new_capacity, size_t old_size) noexcept
+	void* BufferMemory::reallocate(void* old_data, size_t old_capacity, size_t new_capacity, size_t old_size, Flags<Buffer::Hint> hints) noexcept
 	{
 		assert(old_data);
 		assert(old_capacity > 0 && old_capacity == capacity_for_size(old_capacity));
 		assert(new_capacity > 0 && new_capacity == capacity_for_size(new_capacity));
 		assert(old_capacity != new_capacity);
 		if (old_capacity > MaxSmallBlockSize && new_capacity > MaxSmallBlockSize)
-			return vm_reallocate(old_data, old_capacity, new_capacity);
-		const auto new_data = allocate(new_capacity);
+		{
+			const auto new_data = vm_reallocate(old_data, old_capacity, new_capacity);
+			if (new_data)
+			{
+				if (new_capacity > old_capacity)
+				{
+					_large_bytes.fetch_add(new_capacity - old_capacity, std::memory_order_relaxed);
+					add_mapped_bytes(new_capacity - old_capacity);
+				}
+				else
+				{
+					_large_bytes.fetch_sub(old_capacity - new_capacity, std::memory_order_relaxed);
+					_mapped_bytes.fetch_sub(old_capacity - new_capacity, std::memory_order_relaxed);
+				}
+				if (hints != Flags<Buffer::Hint>{})
+					advise(new_data, new_capacity, hints);
+			}
+			return new_data;
+		}
+		if (old_capacity < new_capacity && new_capacity <= MaxSmallBlockSize
+			&& try_grow_in_place(old_data, ::level_from_capacity(old_capacity), ::level_from_capacity(new_capacity)))
+		{
+			if (hints != Flags<Buffer::Hint>{})
+				advise(old_data, new_capacity, hints);
+			return old_data;
+		}
+		const auto new_data = allocate(new_capacity, hints);
 		if (!new_data)
 			return nullptr;
 		if (old_size > 0)
@@ -96,8 +381,105 @@ namespace Yt
 		return new_data;
 	}
 
+	void BufferMemory::release(void* data, size_t capacity, size_t reserved_capacity) noexcept
+	{
+		assert(data);
+		assert(capacity <= reserved_capacity);
+		vm_deallocate(data, reserved_capacity);
+		_large_deallocations.fetch_add(1, std::memory_order_relaxed);
+		_large_bytes.fetch_sub(capacity, std::memory_order_relaxed);
+		_mapped_bytes.fetch_sub(capacity, std::memory_order_relaxed);
+	}
+
+	void* BufferMemory::reserve(size_t reserved_capacity, size_t capacity, Flags<Buffer::Hint> hints) noexcept
+	{
+		assert(capacity <= reserved_capacity);
+		const auto data = vm_reserve(reserved_capacity);
+		if (!data)
+			return nullptr;
+		if (capacity > 0 && !vm_commit(data, capacity))
+		{
+			vm_deallocate(data, reserved_capacity);
+			return nullptr;
+		}
+		advise(data, capacity, reserved_capacity, hints);
+		_large_allocations.fetch_add(1, std::memory_order_relaxed);
+		_large_bytes.fetch_add(capacity, std::memory_order_relaxed);
+		add_mapped_bytes(capacity);
+		return data;
+	}
+
+	void BufferMemory::set_trim_threshold(TrimPolicy policy, size_t retained_bytes) noexcept
+	{
+		std::scoped_lock lock{ _small_blocks_mutex };
+		_trim_threshold = retained_bytes;
+		_trim_policy = policy;
+	}
+
+	BufferStatistics BufferMemory::statistics() noexcept
+	{
+		static_assert(BufferStatistics::LevelCount == ChunkLevel + 1);
+		BufferStatistics statistics;
+		statistics._mapped_bytes = _mapped_bytes.load(std::memory_order_relaxed);
+		statistics._peak_mapped_bytes = _peak_mapped_bytes.load(std::memory_order_relaxed);
+		statistics._large_allocations = _large_allocations.load(std::memory_order_relaxed);
+		statistics._large_deallocations = _large_deallocations.load(std::memory_order_relaxed);
+		statistics._large_bytes = _large_bytes.load(std::memory_order_relaxed);
+		{
+			std::scoped_lock lock{ _small_blocks_mutex };
+			for (size_t level = 0; level < BufferStatistics::LevelCount; ++level)
+			{
+				auto& counters = statistics._levels[level];
+				counters._allocations = _level_counters[level]._allocations;
+				counters._deallocations = _level_counters[level]._deallocations;
+				counters._free_bytes = _counters._free_blocks[level] << level;
+			}
+			for (const BufferCache* cache = _caches; cache; cache = cache->next())
+				cache->update_statistics(statistics);
+		}
+		statistics._allocated_bytes = statistics._large_bytes;
+		for (size_t level = 0; level < BufferStatistics::LevelCount; ++level)
+		{
+			// Thread counters are read without synchronization, so a block allocated by one thread
+			// and deallocated by another may be seen deallocated before it is seen allocated.
+			const auto& counters = statistics._levels[level];
+			const auto blocks = static_cast<ptrdiff_t>(counters._allocations - counters._deallocations);
+			if (blocks > 0)
+				statistics._allocated_bytes += static_cast<size_t>(blocks) << level;
+		}
+		return statistics;
+	}
+
+	size_t BufferMemory::trim(TrimPolicy policy, size_t retained_bytes) noexcept
+	{
+		if (this == &_buffer_memory && _buffer_cache.active())
+			_buffer_cache.flush();
+		size_t trimmed_bytes = 0;
+		size_t retained_chunks = retained_bytes / ChunkSize;
+		std::scoped_lock lock{ _small_blocks_mutex };
+		for (auto block = _small_blocks[ChunkLevel]; block;)
+		{
+			const auto next = static_cast<FreeBlock*>(block)->_next;
+			if (retained_chunks > 0)
+				--retained_chunks;
+			else
+			{
+				trim_chunk(find_chunk(block), policy);
+				trimmed_bytes += ChunkSize;
+			}
+			block = next;
+		}
+		if (policy == TrimPolicy::Release)
+			for (auto i = _chunk_count; i > 0 && _counters._decommitted_chunks > 0; --i)
+				if (_chunks[i - 1]._decommitted)
+					trim_chunk(&_chunks[i - 1], policy);
+		return trimmed_bytes;
+	}
+
 	size_t BufferMemory::capacity_for_size(size_t size) noexcept
 	{
+		if (size < granularity())
+			return size > MinSmallBlockSize ? seir::nextPowerOf2(size) : (size > 0 ? MinSmallBlockSize : 0);
 		const auto granularity_mask = granularity() - 1;
 		auto capacity = (size + granularity_mask) & ~granularity_mask;
 		return capacity > MaxSmallBlockSize ? capacity : seir::nextPowerOf2(capacity);
@@ -109,4 +491,211 @@ namespace Yt
 		assert(seir::isPowerOf2(page_size));
 		return page_size;
 	}
+
+	size_t BufferMemory::total_capacity() noexcept
+	{
+		return _buffer_memory._mapped_bytes.load(std::memory_order_relaxed);
+	}
+
+	BufferMemory::Chunk* BufferMemory::add_chunk() noexcept
+	{
+		if (_chunk_count == _chunk_capacity)
+		{
+			const auto granularity_mask = granularity() - 1;
+			const auto old_size = _chunk_capacity * sizeof(Chunk);
+			const auto new_size = std::max(sizeof(Chunk) + granularity_mask, 2 * old_size + granularity_mask) & ~granularity_mask;
+			const auto new_chunks = _chunks
+				? vm_reallocate(_chunks, old_size, new_size)
+				: vm_allocate(new_size);
+			if (!new_chunks)
+				return nullptr;
+			_chunks = static_cast<Chunk*>(new_chunks);
+			_chunk_capacity = new_size / sizeof(Chunk);
+		}
+		const auto base = static_cast<std::byte*>(vm_allocate(ChunkSize));
+		if (!base)
+			return nullptr;
+		const auto chunk = std::upper_bound(_chunks, _chunks + _chunk_count, base, [](const std::byte* a, const Chunk& b) { return std::less{}(a, b._base); });
+		std::memmove(chunk + 1, chunk, static_cast<size_t>(_chunks + _chunk_count - chunk) * sizeof(Chunk));
+		chunk->_base = base;
+		chunk->_decommitted = false;
+		chunk->_free.reset();
+		++_chunk_count;
+		++_counters._chunks;
+		add_mapped_bytes(ChunkSize);
+		return chunk;
+	}
+
+	void BufferMemory::add_mapped_bytes(size_t bytes) noexcept
+	{
+		const auto mapped_bytes = _mapped_bytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+		auto peak_mapped_bytes = _peak_mapped_bytes.load(std::memory_order_relaxed);
+		while (peak_mapped_bytes < mapped_bytes && !_peak_mapped_bytes.compare_exchange_weak(peak_mapped_bytes, mapped_bytes, std::memory_order_relaxed))
+			;
+	}
+
+	void* BufferMemory::allocate_block(size_t level) noexcept
+	{
+		auto block_level = level;
+		while (block_level <= ChunkLevel && !_small_blocks[block_level])
+			++block_level;
+		Chunk* chunk = nullptr;
+		std::byte* block = nullptr;
+		if (block_level <= ChunkLevel)
+		{
+			block = static_cast<std::byte*>(_small_blocks[block_level]);
+			chunk = find_chunk(block);
+			::unlink_block(_small_blocks[block_level], block);
+			chunk->set_free(block, block_level, false);
+			--_counters._free_blocks[block_level];
+		}
+		else if (_counters._decommitted_chunks > 0)
+		{
+			// A decommitted chunk is reused before mapping a new one.
+			chunk = std::find_if(_chunks, _chunks + _chunk_count, [](const Chunk& c) { return c._decommitted; });
+			assert(chunk != _chunks + _chunk_count);
+			if (!vm_commit(chunk->_base, ChunkSize))
+				return nullptr;
+			chunk->_decommitted = false;
+			chunk->set_free(chunk->_base, ChunkLevel, false);
+			--_counters._decommitted_chunks;
+			add_mapped_bytes(ChunkSize);
+			block = chunk->_base;
+			block_level = ChunkLevel;
+		}
+		else
+		{
+			chunk = add_chunk();
+			if (!chunk)
+				return nullptr;
+			block = chunk->_base;
+			block_level = ChunkLevel;
+		}
+		while (block_level > level)
+		{
+			--block_level;
+			const auto buddy = block + (size_t{ 1 } << block_level);
+			::link_block(_small_blocks[block_level], buddy);
+			chunk->set_free(buddy, block_level, true);
+			++_counters._free_blocks[block_level];
+			++_counters._splits;
+		}
+		return block;
+	}
+
+	size_t BufferMemory::allocate_blocks(size_t level, size_t count, void*& list) noexcept
+	{
+		assert(count > 0);
+		size_t allocated = 0;
+		std::scoped_lock lock{ _small_blocks_mutex };
+		for (; allocated < count; ++allocated)
+		{
+			const auto block = allocate_block(level);
+			if (!block)
+				break;
+			static_cast<Block*>(block)->_next = list;
+			list = block;
+		}
+		return allocated;
+	}
+
+	void BufferMemory::deallocate_block(void* data, size_t level) noexcept
+	{
+		auto block = static_cast<std::byte*>(data);
+		const auto chunk = find_chunk(block);
+		for (; level < ChunkLevel; ++level)
+		{
+			const auto block_size = size_t{ 1 } << level;
+			const auto buddy = chunk->_base + (static_cast<size_t>(block - chunk->_base) ^ block_size);
+			if (!chunk->is_free(buddy, level))
+				break;
+			::unlink_block(_small_blocks[level], buddy);
+			chunk->set_free(buddy, level, false);
+			--_counters._free_blocks[level];
+			++_counters._merges;
+			block = std::min(block, buddy);
+		}
+		::link_block(_small_blocks[level], block);
+		chunk->set_free(block, level, true);
+		++_counters._free_blocks[level];
+		if (level == ChunkLevel && _counters._free_blocks[ChunkLevel] * ChunkSize > _trim_threshold)
+			trim_chunk(chunk, _trim_policy);
+	}
+
+	void BufferMemory::deallocate_blocks(size_t level, void* first, [[maybe_unused]] void* last) noexcept
+	{
+		assert(!static_cast<Block*>(last)->_next);
+		std::scoped_lock lock{ _small_blocks_mutex };
+		for (auto block = first; block;)
+		{
+			const auto next = static_cast<Block*>(block)->_next;
+			deallocate_block(block, level);
+			block = next;
+		}
+	}
+
+	BufferMemory::Chunk* BufferMemory::find_chunk(const void* data) noexcept
+	{
+		const auto block = static_cast<const std::byte*>(data);
+		const auto chunk = std::upper_bound(_chunks, _chunks + _chunk_count, block, [](const std::byte* a, const Chunk& b) { return std::less{}(a, b._base); });
+		assert(chunk != _chunks);
+		assert(block < (chunk - 1)->_base + ChunkSize);
+		return chunk - 1;
+	}
+
+	void BufferMemory::trim_chunk(Chunk* chunk, TrimPolicy policy) noexcept
+	{
+		assert(chunk->is_free(chunk->_base, ChunkLevel));
+		if (chunk->_decommitted)
+		{
+			assert(policy == TrimPolicy::Release);
+			--_counters._decommitted_chunks;
+		}
+		else
+		{
+			// The free list links are stored in the chunk, so it must be unlinked before decommitting.
+			::unlink_block(_small_blocks[ChunkLevel], chunk->_base);
+			--_counters._free_blocks[ChunkLevel];
+			_mapped_bytes.fetch_sub(ChunkSize, std::memory_order_relaxed);
+			if (policy == TrimPolicy::Decommit)
+			{
+				vm_decommit(chunk->_base, ChunkSize);
+				chunk->_decommitted = true;
+				++_counters._decommitted_chunks;
+				return;
+			}
+		}
+		// The chunk is unmapped under the lock, but trimming is rare,
+		// and it's better to wait than to map a new chunk in the meantime.
+		vm_deallocate(chunk->_base, ChunkSize);
+		std::memmove(chunk, chunk + 1, static_cast<size_t>(_chunks + _chunk_count - chunk - 1) * sizeof(Chunk));
+		--_chunk_count;
+		--_counters._chunks;
+	}
+
+	bool BufferMemory::try_grow_in_place(void* data, size_t old_level, size_t new_level) noexcept
+	{
+		assert(old_level < new_level && new_level <= MaxSmallBlockLevel);
+		const auto block = static_cast<std::byte*>(data);
+		std::scoped_lock lock{ _small_blocks_mutex };
+		const auto chunk = find_chunk(block);
+		const auto offset = static_cast<size_t>(block - chunk->_base);
+		if (offset & ((size_t{ 1 } << new_level) - 1))
+			return false;
+		for (auto level = old_level; level < new_level; ++level)
+			if (!chunk->is_free(block + (size_t{ 1 } << level), level))
+				return false;
+		for (auto level = old_level; level < new_level; ++level)
+		{
+			const auto buddy = block + (size_t{ 1 } << level);
+			::unlink_block(_small_blocks[level], buddy);
+			chunk->set_free(buddy, level, false);
+			--_counters._free_blocks[level];
+			++_counters._merges;
+		}
+		++_counters._in_place_reallocations;
+		++_level_counters[old_level]._deallocations;
+		++_level_counters[new_level]._allocations;
+		return true;
+	}
 }
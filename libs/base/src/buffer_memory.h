@@ -4,22 +4,69 @@
 
 #pragma once
 
+#include <yttrium/base/buffer.h>
+
+#include <atomic>
+#include <limits>
 #include <mutex>
 
 namespace Yt
 {
+	class BufferCache;
+
 	class BufferMemory
 	{
 	public:
 		// Internal properties required for proper benchmarking.
+		constexpr static size_t MinSmallBlockLevel = 6;
+		constexpr static size_t MinSmallBlockSize = 1 << MinSmallBlockLevel;
 		constexpr static size_t MaxSmallBlockLevel = 19;
 		constexpr static size_t MaxSmallBlockSize = 1 << MaxSmallBlockLevel;
 
+		// Blocks of up to MaxCachedBlockSize bytes are cached by the allocating threads
+		// and are moved to and from the shared pool in batches of up to CacheBatchSize bytes.
+		constexpr static size_t CacheBatchSize = 1 << 16;
+		constexpr static size_t MaxCachedBlockSize = CacheBatchSize;
+
+		// Small blocks are allocated by splitting chunks of ChunkSize bytes in halves down to the requested size,
+		// so a chunk may hold blocks of different sizes, and free buddies are merged back into larger blocks.
+		constexpr static size_t ChunkLevel = MaxSmallBlockLevel + 1;
+		constexpr static size_t ChunkSize = size_t{ 1 } << ChunkLevel;
+
+		// Buffers using huge pages are aligned to the huge page size.
+		constexpr static size_t HugePageSize = size_t{ 2 } << 20;
+
+		struct FragmentationCounters
+		{
+			size_t _chunks = 0;                    // Chunks allocated for small blocks.
+			size_t _decommitted_chunks = 0;        // Free chunks without physical memory.
+			size_t _free_blocks[ChunkLevel + 1]{}; // Free blocks of each level in the shared pool, excluding decommitted chunks.
+			size_t _splits = 0;                    // Blocks split to allocate smaller blocks.
+			size_t _merges = 0;                    // Blocks merged with their free buddies.
+			size_t _in_place_reallocations = 0;    // Reallocations that didn't move the data.
+		};
+
+		// Specifies how free chunks are returned to the operating system.
+		enum class TrimPolicy
+		{
+			Decommit, // Free physical memory, but keep the address space for reuse.
+			Release,  // Free both physical memory and address space.
+		};
+
 		BufferMemory() = default;
 
-		void* allocate(size_t capacity) noexcept;
+		void advise(void* data, size_t capacity, Flags<Buffer::Hint>) noexcept;
+		void advise(void* data, size_t capacity, size_t reserved_capacity, Flags<Buffer::Hint>) noexcept;
+		void* allocate(size_t capacity, Flags<Buffer::Hint> = {}) noexcept;
+		bool commit(void* data, size_t old_capacity, size_t new_capacity, Flags<Buffer::Hint> = {}) noexcept;
 		void deallocate(void* data, size_t capacity) noexcept;
-		void* reallocate(void* old_data, size_t old_capacity, size_t new_capacity, size_t old_size) noexcept;
+		FragmentationCounters fragmentation_counters() noexcept;
+		void* reallocate(void* old_data, size_t old_capacity, size_t new_capacity, size_t old_size, Flags<Buffer::Hint> = {}) noexcept;
+		void release(void* data, size_t capacity, size_t reserved_capacity) noexcept;
+		void* reserve(size_t reserved_capacity, size_t capacity, Flags<Buffer::Hint> = {}) noexcept;
+		void set_trim_threshold(TrimPolicy, size_t retained_bytes) noexcept;
+		BufferStatistics statistics() noexcept;
+		size_t trim(TrimPolicy, size_t retained_bytes = 0) noexcept;
 
 		static size_t capacity_for_size(size_t) noexcept;
 		static size_t granularity() noexcept;
@@ -29,8 +76,46 @@ namespace Yt
 		BufferMemory& operator=(const BufferMemory&) = delete;
 
 	private:
-		void* _small_blocks[MaxSmallBlockLevel + 1]{};
+		struct Chunk;
+
+		Chunk* add_chunk() noexcept;
+		void add_mapped_bytes(size_t) noexcept;
+		void* allocate_block(size_t level) noexcept;
+		size_t allocate_blocks(size_t level, size_t count, void*& list) noexcept;
+		void deallocate_block(void* block, size_t level) noexcept;
+		void deallocate_blocks(size_t level, void* first, void* last) noexcept;
+		Chunk* find_chunk(const void*) noexcept;
+		void trim_chunk(Chunk*, TrimPolicy) noexcept;
+		bool try_grow_in_place(void* data, size_t old_level, size_t new_level) noexcept;
+
+	private:
 		std::mutex _small_blocks_mutex;
+		void* _small_blocks[ChunkLevel + 1]{};
+		Chunk* _chunks = nullptr; // Sorted by address.
+		size_t _chunk_count = 0;
+		size_t _chunk_capacity = 0;
+		FragmentationCounters _counters;
+		size_t _trim_threshold = std::numeric_limits<size_t>::max();
+		TrimPolicy _trim_policy = TrimPolicy::Release;
+
+		// Small block counters for the shared pool and for terminated threads (guarded by the mutex).
+		struct LevelCounters
+		{
+			size_t _allocations = 0;
+			size_t _deallocations = 0;
+		};
+
+		LevelCounters _level_counters[ChunkLevel + 1];
+		BufferCache* _caches = nullptr; // Thread caches with their own counters (guarded by the mutex).
+
+		// Counters updated without locking.
+		std::atomic<size_t> _mapped_bytes{ 0 };
+		std::atomic<size_t> _peak_mapped_bytes{ 0 };
+		std::atomic<size_t> _large_allocations{ 0 };
+		std::atomic<size_t> _large_deallocations{ 0 };
+		std::atomic<size_t> _large_bytes{ 0 };
+
+		friend class BufferCache;
 	};
 
 	extern BufferMemory _buffer_memory; // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
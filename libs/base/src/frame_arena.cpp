@@ -0,0 +1,61 @@
+// This file is part of the Yttrium toolkit.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <yttrium/base/frame_arena.h>
+
+#include <algorithm>
+#include <cassert>
+
+namespace Yt
+{
+	FrameArena::FrameArena(size_t frames) noexcept
+		: _frames{ frames }
+	{
+		assert(frames > 0 && frames <= MaxFrames);
+	}
+
+	size_t FrameArena::capacity() const noexcept
+	{
+		size_t result = 0;
+		for (size_t i = 0; i < _frames; ++i)
+		{
+			result += _slots[i]._buffer.capacity();
+			for (const auto& block : _slots[i]._overflow)
+				result += block.capacity();
+		}
+		return result;
+	}
+
+	void FrameArena::next_frame() noexcept
+	{
+		++_frame;
+		_slot = (_slot + 1) % _frames;
+		auto& slot = _slots[_slot];
+		if (!slot._overflow.empty())
+		{
+			// The frame didn't fit into a single block, so we replace its blocks with one big enough to hold them all.
+			auto capacity = slot._buffer.capacity();
+			for (const auto& block : slot._overflow)
+				capacity += block.capacity();
+			slot._overflow.clear();
+			[[maybe_unused]] const auto reset = slot._buffer.try_reset(capacity);
+		}
+		_top = static_cast<std::byte*>(slot._buffer.data());
+		_end = _top + slot._buffer.capacity();
+	}
+
+	void* FrameArena::allocate_slow(size_t size, [[maybe_unused]] size_t alignment)
+	{
+		assert(alignment > 0 && !(alignment & (alignment - 1)) && alignment <= Buffer::memory_granularity());
+		auto& slot = _slots[_slot];
+		// Blocks are page-aligned and grow geometrically, so a frame needs only a few of them.
+		const auto last_capacity = slot._overflow.empty() ? slot._buffer.capacity() : slot._overflow.back().capacity();
+		Buffer block{ std::max(size, 2 * last_capacity), Buffer::PageAligned{} };
+		auto& current = slot._buffer.capacity() > 0 ? slot._overflow.emplace_back(std::move(block)) : (slot._buffer = std::move(block));
+		const auto data = static_cast<std::byte*>(current.data());
+		_top = data + size;
+		_end = data + current.capacity();
+		return data;
+	}
+}
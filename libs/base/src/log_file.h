@@ -0,0 +1,34 @@
+// This file is part of the Yttrium toolkit.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string_view>
+
+namespace Yt
+{
+	// Append-only file which writes log messages as lines.
+	class LogFile
+	{
+	public:
+		LogFile() noexcept = default;
+		LogFile(const LogFile&) = delete;
+		~LogFile() noexcept { close(); }
+		LogFile& operator=(const LogFile&) = delete;
+
+		void close() noexcept;
+		bool is_open() const noexcept { return _handle != -1; }
+		bool open(const std::filesystem::path&) noexcept;
+		uint64_t size() const noexcept { return _size; }
+		bool sync() noexcept;
+		bool write(std::span<const std::string_view> messages);
+
+	private:
+		intptr_t _handle = -1; // File descriptor or HANDLE.
+		uint64_t _size = 0;
+	};
+}
@@ -0,0 +1,82 @@
+// This file is part of the Yttrium toolkit.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <yttrium/base/log_sink.h>
+
+#include "log_file.h"
+
+#include <string>
+
+namespace
+{
+	std::filesystem::path rotated_path(const std::filesystem::path& path, size_t index)
+	{
+		auto result = path;
+		result += '.' + std::to_string(index);
+		return result;
+	}
+
+	class FileLogSink final : public Yt::LogSink
+	{
+	public:
+		FileLogSink(const std::filesystem::path& path, const Yt::LogFileOptions& options)
+			: _path{ path }, _options{ options } {}
+
+		~FileLogSink() noexcept override
+		{
+			if (_options._sync != Yt::LogFileSync::Never)
+				_file.sync();
+		}
+
+		bool open() noexcept { return _file.open(_path); }
+
+		void write(std::span<const std::string_view> messages) override
+		{
+			if (_options._max_size > 0 && _file.size() > 0)
+			{
+				uint64_t size = 0;
+				for (const auto message : messages)
+					size += message.size() + 1;
+				if (_file.size() + size > _options._max_size)
+					rotate();
+			}
+			if (_file.write(messages) && _options._sync == Yt::LogFileSync::Batch)
+				_file.sync();
+		}
+
+	private:
+		void rotate()
+		{
+			if (_options._sync != Yt::LogFileSync::Never)
+				_file.sync();
+			_file.close();
+			std::error_code error;
+			if (_options._max_files == 0)
+				std::filesystem::remove(_path, error);
+			else
+			{
+				for (auto i = _options._max_files - 1; i > 0; --i)
+					std::filesystem::rename(::rotated_path(_path, i), ::rotated_path(_path, i + 1), error);
+				std::filesystem::rename(_path, ::rotated_path(_path, 1), error);
+			}
+			_file.open(_path);
+		}
+
+	private:
+		const std::filesystem::path _path;
+		const Yt::LogFileOptions _options;
+		Yt::LogFile _file;
+	};
+}
+
+namespace Yt
+{
+	std::unique_ptr<LogSink> LogSink::open_file(const std::filesystem::path& path, const LogFileOptions& options)
+	{
+		auto sink = std::make_unique<FileLogSink>(path, options);
+		if (!sink->open())
+			return nullptr;
+		return sink;
+	}
+}
@@ -4,19 +4,91 @@
 
 #include <yttrium/base/logger.h>
 
+#include <yttrium/base/log_sink.h>
 #include "ring_log.h"
 
+#include <fmt/args.h>
+#include <fmt/format.h>
+
 #include <atomic>
-#include <cassert>
-#include <condition_variable>
+#include <cstring>
 #include <iostream>
-#include <mutex>
+#include <limits>
+#include <new>
 #include <thread>
+#include <vector>
 
 namespace
 {
-	static_assert(Yt::Logger::MaxMessageSize == Yt::RingLog::MaxStringSize);
+	static_assert(Yt::RingLog::record_size(Yt::Logger::MaxCapturedSize) <= Yt::RingLog::MinCapacity / 2);
+	static_assert(static_cast<int>(Yt::LogLevel::Error) < 4);
+	static_assert(static_cast<int>(Yt::LogCategory::Driver) < 8);
+
+	// Maximum number of messages passed to a sink at once.
+	constexpr size_t MaxBatchSize = 256;
+
+	// Repeated messages are reported at least once per this interval.
+	constexpr auto RepeatReportInterval = std::chrono::seconds{ 1 };
+
+	// Ring log tags contain the message category and whether the message needs formatting.
+	constexpr uint8_t CapturedTag = 1;
+
+	constexpr uint8_t make_tag(Yt::LogCategory category, uint8_t flags) noexcept
+	{
+		return static_cast<uint8_t>(static_cast<unsigned>(category) << 1 | flags);
+	}
+
+	constexpr unsigned tag_category(uint8_t tag) noexcept
+	{
+		return static_cast<unsigned>(tag >> 1);
+	}
+
+	Yt::RingLog::Overflow ring_log_overflow(Yt::LogOverflow overflow) noexcept
+	{
+		switch (overflow)
+		{
+		case Yt::LogOverflow::DropNewest: return Yt::RingLog::Overflow::DropNewest;
+		case Yt::LogOverflow::Block: return Yt::RingLog::Overflow::Block;
+		default: return Yt::RingLog::Overflow::DropOldest;
+		}
+	}
 
+	class CallbackLogSink final : public Yt::LogSink
+	{
+	public:
+		explicit CallbackLogSink(std::function<void(std::string_view)>&& callback) noexcept
+			: _callback{ std::move(callback) } {}
+
+		void write(std::span<const std::string_view> messages) override
+		{
+			for (const auto message : messages)
+				_callback(message);
+		}
+
+	private:
+		const std::function<void(std::string_view)> _callback;
+	};
+
+	// Joins each batch to write it to the standard error stream at once.
+	class StandardErrorLogSink final : public Yt::LogSink
+	{
+	public:
+		void write(std::span<const std::string_view> messages) override
+		{
+			_buffer.clear();
+			for (const auto message : messages)
+			{
+				_buffer.append(message);
+				_buffer.push_back('\n');
+			}
+			std::cerr.write(_buffer.data(), static_cast<std::streamsize>(_buffer.size()));
+		}
+
+	private:
+		std::string _buffer;
+	};
+
+	std::atomic<uint32_t> _collapsed_categories{ 0 };                  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
 	std::atomic<bool> _global_logger_created{ false };                 // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
 	std::atomic<Yt::LoggerPrivate*> _global_logger_private{ nullptr }; // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
 }
@@ -25,17 +97,21 @@ namespace Yt
 {
 	class LoggerPrivate
 	{
+		static constexpr auto NoCategory = std::numeric_limits<unsigned>::max();
+
 	public:
-		[[nodiscard]] static std::unique_ptr<LoggerPrivate> create(std::function<void(std::string_view)>&& callback)
+		[[nodiscard]] static std::unique_ptr<LoggerPrivate> create(std::unique_ptr<LogSink>&& sink, const LoggerOptions& options)
 		{
 			bool expected = false;
 			return _global_logger_created.compare_exchange_strong(expected, true)
-				? std::make_unique<LoggerPrivate>(std::move(callback))
+				? std::make_unique<LoggerPrivate>(std::move(sink), options)
 				: nullptr;
 		}
 
-		explicit LoggerPrivate(std::function<void(std::string_view)>&& callback) //-V730
-			: _thread{ [this, cb = std::move(callback)] { run(cb ? cb : [](std::string_view message) { std::cerr << message << '\n'; }); } }
+		LoggerPrivate(std::unique_ptr<LogSink>&& sink, const LoggerOptions& options) //-V730
+			: _ring_log{ options._capacity, ::ring_log_overflow(options._overflow), options._block_timeout }
+			, _sink{ sink ? std::move(sink) : std::make_unique<StandardErrorLogSink>() }
+			, _thread{ [this] { run(); } }
 		{
 			_global_logger_private = this;
 		}
@@ -43,74 +119,236 @@ namespace Yt
 		~LoggerPrivate() noexcept
 		{
 			_global_logger_private = nullptr;
-			{
-				std::scoped_lock lock{ _mutex };
-				_stop = true;
-			}
-			_flushed.notify_all();
-			_can_process.notify_one();
+			_stop.store(true);
+			wake();
 			_thread.join();
 			_global_logger_created = false;
 		}
 
 		void flush() noexcept
 		{
-			std::unique_lock lock{ _mutex };
-			++_flushing;
-			_flushed.wait(lock, [this] { return (_ring_log.empty() && !_processing) || _stop; });
-			--_flushing;
+			const auto target = _ring_log.end();
+			_flushing.fetch_add(1);
+			for (auto processed = _processed.load(); processed < target && !_stop.load(); processed = _processed.load())
+				_processed.wait(processed);
+			_flushing.fetch_sub(1);
 		}
 
-		void push(std::string_view message) noexcept
+		LoggerStatistics statistics() const noexcept
 		{
+			LoggerStatistics result;
+			result._capacity = _ring_log.capacity();
+			result._high_water_mark = _ring_log.high_water_mark();
+			result._dropped_messages = _ring_log.dropped();
+			result._dropped_bytes = _ring_log.dropped_bytes();
+			return result;
+		}
+
+		void push(std::string_view message, uint8_t tag) noexcept
+		{
+			_ring_log.push(message, tag);
+			// The message is committed with a sequentially consistent store,
+			// so either we see the logger thread going to sleep or it sees the message.
+			if (_sleeping.load() && _sleeping.exchange(false))
+				wake();
+		}
+
+		// Formats a message captured by Logger::log.
+		static void format(std::string_view record, fmt::dynamic_format_arg_store<fmt::format_context>& arguments, std::string& message)
+		{
+			std::string_view format_string;
+			record = read(record, format_string);
+			arguments.clear();
+			while (!record.empty())
 			{
-				std::scoped_lock lock{ _mutex };
-				const auto need_notify = _ring_log.empty() && !_processing && !_flushing;
-				_ring_log.push(message);
-				if (!need_notify)
-					return;
+				const auto type = static_cast<Logger::ArgumentType>(record.front());
+				record.remove_prefix(1);
+				switch (type)
+				{
+				case Logger::ArgumentType::Bool: record = push_argument<char, bool>(record, arguments); break;
+				case Logger::ArgumentType::Char: record = push_argument<char>(record, arguments); break;
+				case Logger::ArgumentType::Int: record = push_argument<int64_t>(record, arguments); break;
+				case Logger::ArgumentType::UInt: record = push_argument<uint64_t>(record, arguments); break;
+				case Logger::ArgumentType::Float: record = push_argument<float>(record, arguments); break;
+				case Logger::ArgumentType::Double: record = push_argument<double>(record, arguments); break;
+				case Logger::ArgumentType::Pointer: record = push_argument<const void*>(record, arguments); break;
+				case Logger::ArgumentType::String: {
+					uint16_t size = 0;
+					record = read(record, size);
+					arguments.push_back(record.substr(0, size));
+					record.remove_prefix(size);
+					break;
+				}
+				case Logger::ArgumentType::StringReference: record = push_argument<std::string_view>(record, arguments); break;
+				}
+			}
+			message.clear();
+			try
+			{
+				fmt::vformat_to(std::back_inserter(message), format_string, arguments);
+			}
+			catch (const fmt::format_error& e)
+			{
+				message = fmt::format("(Log format error: {}) {}", e.what(), format_string);
 			}
-			_can_process.notify_one();
 		}
 
 	private:
-		void run(const std::function<void(std::string_view)>& callback)
+		template <typename Stored, typename Pushed = Stored>
+		static std::string_view push_argument(std::string_view record, fmt::dynamic_format_arg_store<fmt::format_context>& arguments)
+		{
+			Stored value{};
+			record = read(record, value);
+			arguments.push_back(static_cast<Pushed>(value));
+			return record;
+		}
+
+		template <typename T>
+		static std::string_view read(std::string_view record, T& value) noexcept
 		{
-			std::string message;
-			for (std::unique_lock lock{ _mutex };;)
+			std::memcpy(&value, record.data(), sizeof value);
+			return record.substr(sizeof value);
+		}
+
+		std::string& batch_message(size_t index)
+		{
+			if (index == _messages.size())
+				_messages.emplace_back();
+			return _messages[index];
+		}
+
+		// Appends a report of the collapsed repeats, if any.
+		void report_repeats(size_t& count)
+		{
+			if (!_repeats)
+				return;
+			auto& message = batch_message(count++);
+			message.clear();
+			fmt::format_to(std::back_inserter(message), "(last message repeated {} times)", _repeats);
+			_repeats = 0;
+		}
+
+		// Returns true if the last popped message should be written, or false if it is a collapsed repeat.
+		bool filter_repeats(size_t& count, unsigned category)
+		{
+			const auto collapsible = (_collapsed_categories.load(std::memory_order_relaxed) >> category) & 1;
+			if (collapsible && _last_category == category && _messages[count] == _last_message)
 			{
-				_can_process.wait(lock, [this] { return !_ring_log.empty() || _stop; });
-				if (_stop && _ring_log.empty())
-					break;
-				assert(!_ring_log.empty());
-				_ring_log.pop(message);
-				_processing = true;
-				lock.unlock();
-				callback(message);
-				lock.lock();
-				_processing = false;
-				if (_flushing > 0 && _ring_log.empty())
+				const auto now = std::chrono::steady_clock::now();
+				if (!_repeats)
+					_repeats_start = now;
+				++_repeats;
+				if (now - _repeats_start >= RepeatReportInterval)
+					report_repeats(count);
+				return false;
+			}
+			if (_repeats)
+			{
+				// The report goes before the new message.
+				batch_message(count + 1);
+				std::swap(_messages[count], _messages[count + 1]);
+				report_repeats(count);
+			}
+			if (collapsible)
+			{
+				_last_message = _messages[count];
+				_last_category = category;
+			}
+			else
+				_last_category = NoCategory;
+			return true;
+		}
+
+		void run()
+		{
+			std::string record;
+			for (;;)
+			{
+				size_t count = 0;
+				if (const auto dropped = _ring_log.dropped(); dropped != _reported_drops)
 				{
-					lock.unlock();
-					_flushed.notify_all();
-					lock.lock();
+					report_repeats(count);
+					auto& message = batch_message(count++);
+					message.clear();
+					fmt::format_to(std::back_inserter(message), "({} messages dropped)", dropped - _reported_drops);
+					_reported_drops = dropped;
 				}
+				while (count < MaxBatchSize)
+				{
+					auto& message = batch_message(count);
+					uint8_t tag = 0;
+					if (!_ring_log.pop(message, tag))
+						break;
+					if (tag & CapturedTag)
+					{
+						std::swap(message, record);
+						format(record, _arguments, message);
+					}
+					if (filter_repeats(count, ::tag_category(tag)))
+						++count;
+				}
+				if (!count && _stop.load() && _ring_log.empty())
+					report_repeats(count);
+				if (count > 0)
+				{
+					_batch.assign(_messages.begin(), _messages.begin() + static_cast<ptrdiff_t>(count));
+					_sink->write(_batch);
+				}
+				// Everything before the claimed position has been either processed or dropped.
+				_processed.store(_ring_log.begin());
+				if (_flushing.load() > 0)
+					_processed.notify_all();
+				if (count > 0)
+					continue;
+				if (_stop.load())
+				{
+					if (_ring_log.empty())
+						break;
+					std::this_thread::yield(); // Wait for the producers to commit the remaining messages.
+					continue;
+				}
+				const auto wakeups = _wakeups.load();
+				_sleeping.store(true);
+				if (_ring_log.ready() || _stop.load())
+					_sleeping.store(false, std::memory_order_relaxed);
+				else
+					_wakeups.wait(wakeups);
 			}
+			_processed.notify_all();
+		}
+
+		void wake() noexcept
+		{
+			_wakeups.fetch_add(1);
+			_wakeups.notify_one();
 		}
 
 	private:
-		std::mutex _mutex;
-		bool _stop = false;
-		bool _processing = false;
-		size_t _flushing = 0;
-		std::condition_variable _can_process;
-		std::condition_variable _flushed;
 		RingLog _ring_log;
+		const std::unique_ptr<LogSink> _sink;
+		std::vector<std::string> _messages;
+		std::vector<std::string_view> _batch;
+		fmt::dynamic_format_arg_store<fmt::format_context> _arguments;
+		uint64_t _reported_drops = 0;
+		std::string _last_message;
+		unsigned _last_category = NoCategory;
+		uint64_t _repeats = 0;
+		std::chrono::steady_clock::time_point _repeats_start;
+		std::atomic<bool> _stop{ false };
+		std::atomic<bool> _sleeping{ false };
+		std::atomic<uint32_t> _wakeups{ 0 };
+		std::atomic<uint64_t> _processed{ 0 };
+		std::atomic<size_t> _flushing{ 0 };
 		std::thread _thread;
 	};
 
-	Logger::Logger(std::function<void(std::string_view)>&& callback)
-		: _private{ LoggerPrivate::create(std::move(callback)) }
+	Logger::Logger(std::function<void(std::string_view)>&& callback, const LoggerOptions& options)
+		: Logger{ callback ? std::make_unique<CallbackLogSink>(std::move(callback)) : nullptr, options }
+	{
+	}
+
+	Logger::Logger(std::unique_ptr<LogSink>&& sink, const LoggerOptions& options)
+		: _private{ LoggerPrivate::create(std::move(sink), options) }
 	{
 	}
 
@@ -122,9 +360,79 @@ namespace Yt
 			logger->flush();
 	}
 
-	void Logger::write(std::string_view message) noexcept
+	void Logger::set_collapse_repeats(LogCategory category, bool collapse) noexcept
+	{
+		const auto bit = uint32_t{ 1 } << static_cast<unsigned>(category);
+		if (collapse)
+			_collapsed_categories.fetch_or(bit, std::memory_order_relaxed);
+		else
+			_collapsed_categories.fetch_and(~bit, std::memory_order_relaxed);
+	}
+
+	void Logger::set_level(LogCategory category, LogLevel level) noexcept
+	{
+		const auto category_bits = filter_bit(LogLevel::Debug, category) * 0b1111;
+		const auto enabled_bits = category_bits & ~(filter_bit(level, category) - 1);
+		for (auto filter = _filter.load(std::memory_order_relaxed);;)
+			if (_filter.compare_exchange_weak(filter, (filter & ~category_bits) | enabled_bits, std::memory_order_relaxed))
+				break;
+	}
+
+	void Logger::set_rate_limit(LogCategory category, uint32_t messages_per_second) noexcept
+	{
+		_rate_limits[static_cast<size_t>(category)].store(messages_per_second, std::memory_order_relaxed);
+	}
+
+	LoggerStatistics Logger::statistics() noexcept
 	{
 		if (const auto logger = _global_logger_private.load())
-			logger->push(message);
+			return logger->statistics();
+		return {};
+	}
+
+	void Logger::write(LogCategory category, std::string_view message) noexcept
+	{
+		if (const auto logger = _global_logger_private.load())
+			logger->push(message, ::make_tag(category, 0));
+	}
+
+	void Logger::write_captured(LogCategory category, std::string_view record) noexcept
+	{
+		if (const auto logger = _global_logger_private.load())
+			logger->push(record, ::make_tag(category, CapturedTag));
+	}
+
+	void Logger::write_formatted(LogCategory category, std::string_view record) noexcept
+	{
+		if (const auto logger = _global_logger_private.load())
+		{
+			try
+			{
+				fmt::dynamic_format_arg_store<fmt::format_context> arguments;
+				std::string message;
+				LoggerPrivate::format(record, arguments, message);
+				logger->push(message, ::make_tag(category, 0));
+			}
+			catch (const std::bad_alloc&)
+			{
+				// The message is lost.
+			}
+		}
+	}
+
+	bool LogCallSite::allow_limited(LogCategory category, uint32_t limit) noexcept
+	{
+		const auto now = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+		auto window_start = _window_start.load(std::memory_order_relaxed);
+		if (now - window_start >= 1000 && _window_start.compare_exchange_strong(window_start, now, std::memory_order_relaxed))
+		{
+			_count.store(0, std::memory_order_relaxed);
+			if (const auto suppressed = _suppressed.exchange(0, std::memory_order_relaxed))
+				Logger::log(category, "({} messages suppressed by the rate limit)", suppressed);
+		}
+		if (_count.fetch_add(1, std::memory_order_relaxed) < limit)
+			return true;
+		_suppressed.fetch_add(1, std::memory_order_relaxed);
+		return false;
 	}
 }
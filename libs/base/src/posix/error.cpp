@@ -15,9 +15,9 @@ namespace Yt
 	void report_errno(const char* function) noexcept
 	{
 		const auto error = errno;
-		std::array<char, Logger::MaxMessageSize + 1> buffer;
+		std::array<char, 256> buffer;
 		const auto written = static_cast<size_t>(std::snprintf(buffer.data(), buffer.size(), "[%s] (%d) ", function, error));
-		if (written < Logger::MaxMessageSize)
+		if (written < buffer.size() - 1)
 		{
 			const auto status = ::strerror_r(error, buffer.data() + written, buffer.size() - written);
 #if (_POSIX_C_SOURCE >= 200112L) && !_GNU_SOURCE
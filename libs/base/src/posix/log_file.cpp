@@ -0,0 +1,99 @@
+// This file is part of the Yttrium toolkit.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "../log_file.h"
+
+#include "error.h"
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+
+#include <fcntl.h>    // open
+#include <sys/stat.h> // fstat
+#include <sys/uio.h>  // writev
+#include <unistd.h>   // close, fsync
+
+namespace Yt
+{
+	void LogFile::close() noexcept
+	{
+		if (_handle != -1 && ::close(static_cast<int>(_handle)) != 0)
+			report_errno("close");
+		_handle = -1;
+		_size = 0;
+	}
+
+	bool LogFile::open(const std::filesystem::path& path) noexcept
+	{
+		close();
+		const auto descriptor = ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+		if (descriptor == -1)
+		{
+			report_errno("open");
+			return false;
+		}
+		if (struct stat status; ::fstat(descriptor, &status) == -1)
+			report_errno("fstat");
+		else
+			_size = static_cast<uint64_t>(status.st_size);
+		_handle = descriptor;
+		return true;
+	}
+
+	bool LogFile::sync() noexcept
+	{
+		if (_handle == -1)
+			return false;
+		if (::fdatasync(static_cast<int>(_handle)) == 0)
+			return true;
+		report_errno("fdatasync");
+		return false;
+	}
+
+	bool LogFile::write(std::span<const std::string_view> messages)
+	{
+		if (_handle == -1)
+			return false;
+		static constexpr char newline = '\n';
+		// Every message takes two vectors, and batches larger than IOV_MAX are written in several calls.
+		std::array<iovec, 1024> vectors;
+		while (!messages.empty())
+		{
+			const auto count = std::min(messages.size(), vectors.size() / 2);
+			for (size_t i = 0; i < count; ++i)
+			{
+				vectors[2 * i] = { const_cast<char*>(messages[i].data()), messages[i].size() };
+				vectors[2 * i + 1] = { const_cast<char*>(&newline), 1 };
+			}
+			messages = messages.subspan(count);
+			auto next = vectors.data();
+			for (auto remaining = static_cast<int>(2 * count); remaining > 0;)
+			{
+				const auto written = ::writev(static_cast<int>(_handle), next, remaining);
+				if (written == -1)
+				{
+					if (errno == EINTR)
+						continue;
+					report_errno("writev");
+					return false;
+				}
+				_size += static_cast<uint64_t>(written);
+				for (auto left = static_cast<size_t>(written); left > 0;)
+				{
+					if (left < next->iov_len)
+					{
+						next->iov_base = static_cast<char*>(next->iov_base) + left;
+						next->iov_len -= left;
+						break;
+					}
+					left -= next->iov_len;
+					++next;
+					--remaining;
+				}
+			}
+		}
+		return true;
+	}
+}
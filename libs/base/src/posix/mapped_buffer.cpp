@@ -0,0 +1,66 @@
+// This file is part of the Yttrium toolkit.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <yttrium/base/mapped_buffer.h>
+
+#include "error.h"
+
+#include <fcntl.h>    // open
+#include <sys/mman.h> // madvise, mmap, munmap
+#include <sys/stat.h> // fstat
+#include <unistd.h>   // close
+
+namespace Yt
+{
+	std::optional<MappedBuffer> MappedBuffer::open(const std::filesystem::path& path, Flags<Hint> hints) noexcept
+	{
+		const auto descriptor = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+		if (descriptor == -1)
+		{
+			report_errno("open");
+			return {};
+		}
+		std::optional<MappedBuffer> result;
+		if (struct stat status; ::fstat(descriptor, &status) == -1)
+			report_errno("fstat");
+		else if (status.st_size == 0)
+			result.emplace(); // Empty files can't be mapped.
+		else if (const auto data = ::mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, descriptor, 0); data == MAP_FAILED)
+			report_errno("mmap");
+		else
+		{
+			result.emplace();
+			result->_data = data;
+			result->_size = static_cast<size_t>(status.st_size);
+			result->advise(hints);
+		}
+		::close(descriptor); // The mapping keeps its own reference to the file.
+		return result;
+	}
+
+	MappedBuffer::~MappedBuffer() noexcept
+	{
+		if (_data && ::munmap(const_cast<void*>(_data), _size) != 0)
+			report_errno("munmap");
+	}
+
+	MappedBuffer& MappedBuffer::operator=(MappedBuffer&& other) noexcept
+	{
+		if (_data && ::munmap(const_cast<void*>(_data), _size) != 0)
+			report_errno("munmap");
+		_data = std::exchange(other._data, nullptr);
+		_size = std::exchange(other._size, 0);
+		return *this;
+	}
+
+	void MappedBuffer::advise(Flags<Hint> hints) const noexcept
+	{
+		if (!_data)
+			return;
+		if (hints & Hint::Sequential && ::madvise(const_cast<void*>(_data), _size, MADV_SEQUENTIAL) != 0)
+			report_errno("madvise");
+		if (hints & Hint::WillNeed && ::madvise(const_cast<void*>(_data), _size, MADV_WILLNEED) != 0)
+			report_errno("madvise");
+	}
+}
@@ -6,9 +6,10 @@
 
 #include "error.h"
 
+#include <cstdint>
 #include <cstring>
 
-#include <sys/mman.h> // mmap, munmap
+#include <sys/mman.h> // madvise, mlock, mmap, mprotect, mremap, munmap
 #include <unistd.h>   // sysconf
 
 namespace Yt
@@ -22,12 +23,45 @@ namespace Yt
 		return nullptr;
 	}
 
+	void* vm_allocate_aligned(size_t size, size_t alignment) noexcept
+	{
+		// Map extra space and unmap the unaligned head and the excess tail.
+		const auto result = ::mmap(nullptr, size + alignment, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (result == MAP_FAILED)
+		{
+			report_errno("mmap");
+			return nullptr;
+		}
+		const auto base = static_cast<std::byte*>(result);
+		const auto head = (alignment - reinterpret_cast<uintptr_t>(base) % alignment) % alignment;
+		if (head > 0 && ::munmap(base, head) != 0)
+			report_errno("munmap");
+		if (::munmap(base + head + size, alignment - head) != 0)
+			report_errno("munmap");
+		return base + head;
+	}
+
+	bool vm_commit(void* pointer, size_t size) noexcept
+	{
+		// Decommitted pages are restored on first access, but reserved pages are inaccessible.
+		if (::mprotect(pointer, size, PROT_READ | PROT_WRITE) == 0)
+			return true;
+		report_errno("mprotect");
+		return false;
+	}
+
 	void vm_deallocate(void* pointer, size_t size) noexcept
 	{
 		if (::munmap(pointer, size) != 0)
 			report_errno("munmap");
 	}
 
+	void vm_decommit(void* pointer, size_t size) noexcept
+	{
+		if (::madvise(pointer, size, MADV_DONTNEED) != 0)
+			report_errno("madvise");
+	}
+
 	size_t vm_granularity() noexcept
 	{
 		if (const auto page_size = ::sysconf(_SC_PAGESIZE); page_size > 0)
@@ -36,9 +70,35 @@ namespace Yt
 		return 1;
 	}
 
+	bool vm_lock(void* pointer, size_t size) noexcept
+	{
+		if (::mlock(pointer, size) == 0)
+			return true;
+		report_errno("mlock");
+		return false;
+	}
+
+	bool vm_populate([[maybe_unused]] void* pointer, [[maybe_unused]] size_t size) noexcept
+	{
+#ifdef MADV_POPULATE_WRITE
+		// Requires Linux 5.14, so failures are expected and not reported.
+		return ::madvise(pointer, size, MADV_POPULATE_WRITE) == 0;
+#else
+		return false;
+#endif
+	}
+
 	void* vm_reallocate(void* old_pointer, size_t old_size, size_t new_size) noexcept
 	{
-		// 'mremap' is Linux-specific and known to be very slow.
+#ifdef __linux__
+		// 'mremap' moves page table entries instead of copying the data.
+		// Growing a region by 8 MiB from 8 MiB to 256 MiB takes 0.17 s with 'mremap' and 3.6 s with 'memcpy' (see the buffer_growth benchmark).
+		const auto result = ::mremap(old_pointer, old_size, new_size, MREMAP_MAYMOVE);
+		if (result != MAP_FAILED)
+			return result;
+		report_errno("mremap");
+		return nullptr;
+#else
 		const auto new_pointer = ::mmap(nullptr, new_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
 		if (new_pointer == MAP_FAILED)
 		{
@@ -49,5 +109,23 @@ namespace Yt
 		if (::munmap(old_pointer, old_size) != 0)
 			report_errno("munmap");
 		return new_pointer;
+#endif
+	}
+
+	void* vm_reserve(size_t size) noexcept
+	{
+		const auto result = ::mmap(nullptr, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+		if (result != MAP_FAILED)
+			return result;
+		report_errno("mmap");
+		return nullptr;
+	}
+
+	void vm_use_huge_pages([[maybe_unused]] void* pointer, [[maybe_unused]] size_t size) noexcept
+	{
+#ifdef MADV_HUGEPAGE
+		if (::madvise(pointer, size, MADV_HUGEPAGE) != 0)
+			report_errno("madvise");
+#endif
 	}
 }
@@ -0,0 +1,318 @@
+// This file is part of the Yttrium toolkit.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <yttrium/base/profiler.h>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace
+{
+	// One more slot for the event being recorded while the trace is being built.
+	constexpr size_t RingSize = Yt::Profiler::MaxThreadEvents + 1;
+	static_assert((RingSize & (RingSize - 1)) == 0);
+
+	// Single-producer event ring of a thread.
+	// Event fields are atomic so that the trace can be built while the thread keeps recording,
+	// and the events which may have been overwritten during the copy are discarded.
+	class ThreadEvents
+	{
+	public:
+		struct Event
+		{
+			const char* _name;
+			int64_t _start;
+			int64_t _end;
+		};
+
+		void clear() noexcept
+		{
+			_begin.store(_head.load(std::memory_order_relaxed), std::memory_order_relaxed);
+		}
+
+		// Copies the available events and returns the number of them.
+		size_t copy(std::vector<Event>& events) const
+		{
+			const auto head = _head.load(std::memory_order_acquire);
+			const auto first = std::max(_begin.load(std::memory_order_relaxed), head > Yt::Profiler::MaxThreadEvents ? head - Yt::Profiler::MaxThreadEvents : 0);
+			const auto offset = events.size();
+			for (auto i = first; i < head; ++i)
+			{
+				const auto& slot = _events[i % RingSize];
+				events.push_back({ slot._name.load(std::memory_order_acquire), slot._start.load(std::memory_order_acquire), slot._end.load(std::memory_order_acquire) });
+			}
+			// Discard the events which may have been overwritten while being copied.
+			// Reading any part of an overwriting event makes its index visible here.
+			const auto new_head = _head.load(std::memory_order_relaxed);
+			if (new_head > Yt::Profiler::MaxThreadEvents && new_head - Yt::Profiler::MaxThreadEvents > first)
+			{
+				const auto overwritten = std::min(new_head - Yt::Profiler::MaxThreadEvents, head) - first;
+				events.erase(events.begin() + static_cast<ptrdiff_t>(offset), events.begin() + static_cast<ptrdiff_t>(offset + overwritten));
+			}
+			return events.size() - offset;
+		}
+
+		// Zero for the rings which aren't owned by any thread.
+		constexpr uint32_t id() const noexcept { return _id; }
+
+		const char* name() const noexcept { return _name.load(std::memory_order_relaxed); }
+
+		void push(const char* name, int64_t start, int64_t end) noexcept
+		{
+			const auto head = _head.load(std::memory_order_relaxed);
+			auto& slot = _events[head % RingSize];
+			slot._name.store(name, std::memory_order_release);
+			slot._start.store(start, std::memory_order_release);
+			slot._end.store(end, std::memory_order_release);
+			_head.store(head + 1, std::memory_order_release);
+		}
+
+		void reset(uint32_t id) noexcept
+		{
+			_id = id;
+			_name.store(nullptr, std::memory_order_relaxed);
+			clear();
+		}
+
+		void set_name(const char* name) noexcept { _name.store(name, std::memory_order_relaxed); }
+
+	private:
+		struct Slot
+		{
+			std::atomic<const char*> _name{ nullptr };
+			std::atomic<int64_t> _start{ 0 };
+			std::atomic<int64_t> _end{ 0 };
+		};
+
+		uint32_t _id = 0;
+		std::atomic<const char*> _name{ nullptr };
+		std::atomic<size_t> _head{ 0 };
+		std::atomic<size_t> _begin{ 0 };
+		std::array<Slot, RingSize> _events;
+	};
+
+	// Events which were recorded by an exited thread.
+	struct FinishedThread
+	{
+		uint32_t _id;
+		const char* _name;
+		std::vector<ThreadEvents::Event> _events;
+	};
+
+	// Rings of exited threads are reused by new threads, and their events are kept until cleared.
+	class ThreadRegistry
+	{
+	public:
+		// Returns null if there is not enough memory for a new ring.
+		ThreadEvents* acquire() noexcept
+		{
+			std::scoped_lock lock{ _mutex };
+			auto i = std::find_if(_rings.begin(), _rings.end(), [](const auto& ring) { return !ring->id(); });
+			if (i == _rings.end())
+			{
+				try
+				{
+					_rings.emplace_back(std::make_unique<ThreadEvents>());
+				}
+				catch (const std::bad_alloc&)
+				{
+					return nullptr;
+				}
+				i = std::prev(_rings.end());
+			}
+			(*i)->reset(++_last_id);
+			return i->get();
+		}
+
+		void clear() noexcept
+		{
+			std::scoped_lock lock{ _mutex };
+			for (const auto& ring : _rings)
+				ring->clear();
+			_finished.clear();
+		}
+
+		// Copies the events of the running threads after the events of the exited ones,
+		// and returns the threads in the same order.
+		template <typename Thread>
+		void copy(std::vector<Thread>& threads, std::vector<ThreadEvents::Event>& events)
+		{
+			std::scoped_lock lock{ _mutex };
+			threads.reserve(_finished.size() + _rings.size());
+			for (const auto& thread : _finished)
+			{
+				events.insert(events.end(), thread._events.begin(), thread._events.end());
+				threads.push_back({ thread._id, thread._name, thread._events.size() });
+			}
+			for (const auto& ring : _rings)
+				if (ring->id())
+					threads.push_back({ ring->id(), ring->name(), ring->copy(events) });
+		}
+
+		void release(ThreadEvents& ring) noexcept
+		{
+			std::scoped_lock lock{ _mutex };
+			try
+			{
+				FinishedThread thread{ ring.id(), ring.name(), {} };
+				ring.copy(thread._events);
+				if (thread._name || !thread._events.empty())
+					_finished.emplace_back(std::move(thread));
+			}
+			catch (const std::bad_alloc&)
+			{
+				// The events of the thread are lost.
+			}
+			ring.reset(0);
+		}
+
+	private:
+		std::mutex _mutex;
+		uint32_t _last_id = 0;
+		std::vector<std::unique_ptr<ThreadEvents>> _rings;
+		std::vector<FinishedThread> _finished;
+	};
+
+	ThreadRegistry& thread_registry()
+	{
+		static ThreadRegistry registry;
+		return registry;
+	}
+
+	// Acquires a ring when the thread records its first event, and releases it when the thread exits.
+	class ThreadEventsOwner
+	{
+	public:
+		ThreadEventsOwner() noexcept = default;
+
+		~ThreadEventsOwner() noexcept
+		{
+			_exited = true;
+			if (_events)
+				::thread_registry().release(*std::exchange(_events, nullptr));
+		}
+
+		// Returns null if the ring can't be allocated or the thread is exiting.
+		ThreadEvents* events() noexcept
+		{
+			if (!_events && !_exited) [[unlikely]]
+				_events = ::thread_registry().acquire();
+			return _events;
+		}
+
+		ThreadEventsOwner(const ThreadEventsOwner&) = delete;
+		ThreadEventsOwner& operator=(const ThreadEventsOwner&) = delete;
+
+	private:
+		ThreadEvents* _events = nullptr;
+		bool _exited = false;
+	};
+
+	thread_local ThreadEventsOwner _thread_events; // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+	void append_json_string(std::string& out, std::string_view text)
+	{
+		out += '"';
+		for (const auto c : text)
+		{
+			if (c == '"' || c == '\\')
+			{
+				out += '\\';
+				out += c;
+			}
+			else if (static_cast<unsigned char>(c) < 0x20)
+				fmt::format_to(std::back_inserter(out), "\\u{:04x}", static_cast<unsigned>(c));
+			else
+				out += c;
+		}
+		out += '"';
+	}
+}
+
+namespace Yt
+{
+	void Profiler::clear() noexcept
+	{
+		::thread_registry().clear();
+	}
+
+	void Profiler::set_enabled(bool enabled) noexcept
+	{
+		_enabled.store(enabled, std::memory_order_relaxed);
+	}
+
+	void Profiler::set_thread_name(const char* name) noexcept
+	{
+		if (const auto events = _thread_events.events())
+			events->set_name(name);
+	}
+
+	std::string Profiler::trace()
+	{
+		struct Thread
+		{
+			uint32_t _id;
+			const char* _name;
+			size_t _events;
+		};
+
+		std::vector<Thread> threads;
+		std::vector<ThreadEvents::Event> events;
+		::thread_registry().copy(threads, events);
+
+		auto origin = std::numeric_limits<int64_t>::max();
+		for (const auto& event : events)
+			origin = std::min(origin, event._start);
+
+		std::string result = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+		bool first = true;
+		auto event = events.cbegin();
+		for (const auto& thread : threads)
+		{
+			if (thread._name)
+			{
+				result += first ? "\n" : ",\n";
+				first = false;
+				fmt::format_to(std::back_inserter(result), R"({{"name":"thread_name","ph":"M","pid":1,"tid":{},"args":{{"name":)", thread._id);
+				::append_json_string(result, thread._name);
+				result += "}}";
+			}
+			for (const auto end = event + static_cast<ptrdiff_t>(thread._events); event != end; ++event)
+			{
+				result += first ? "\n" : ",\n";
+				first = false;
+				result += R"({"name":)";
+				::append_json_string(result, event->_name);
+				fmt::format_to(std::back_inserter(result), R"(,"ph":"X","pid":1,"tid":{},"ts":{:.3f},"dur":{:.3f}}})",
+					thread._id, static_cast<double>(event->_start - origin) / 1000.0, static_cast<double>(event->_end - event->_start) / 1000.0);
+			}
+		}
+		result += "\n]}\n";
+		return result;
+	}
+
+	bool Profiler::write_trace(const std::filesystem::path& path)
+	{
+		const auto trace = Profiler::trace();
+		std::ofstream stream{ path, std::ios::binary | std::ios::trunc };
+		stream.write(trace.data(), static_cast<std::streamsize>(trace.size()));
+		return static_cast<bool>(stream.flush());
+	}
+
+	void Profiler::record(const char* name, int64_t start) noexcept
+	{
+		if (const auto events = _thread_events.events()) [[likely]]
+			events->push(name, start, now());
+	}
+}
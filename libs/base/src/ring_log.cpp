@@ -7,58 +7,216 @@
 #include <seir_base/int_utils.hpp>
 
 #include <algorithm>
-#include <cassert>
+#include <bit>
 #include <cstring>
+#include <limits>
+#include <thread>
 
 namespace
 {
-	static_assert(seir::isPowerOf2(Yt::RingLog::BufferSize));
+	static_assert(seir::isPowerOf2(Yt::RingLog::MinCapacity));
+	static_assert(Yt::RingLog::record_size(Yt::RingLog::MaxStringSize) <= std::numeric_limits<uint32_t>::max());
 
-	// If BufferSize is a power of two, we can wrap offsets using masking.
-	constexpr auto OffsetMask = Yt::RingLog::BufferSize - 1;
+	// The capacity is a power of two, so we can wrap offsets using masking.
+	constexpr size_t round_capacity(size_t capacity) noexcept
+	{
+		return std::bit_ceil(std::max(capacity, Yt::RingLog::MinCapacity));
+	}
+
+	// A record header contains the record size in the lower half, then the string size and the tag in the upper byte.
+	// Zero header means the record hasn't been committed yet.
+	constexpr uint64_t make_header(size_t record_size, size_t string_size, uint8_t tag) noexcept
+	{
+		return (uint64_t{ tag } << 56) | (uint64_t{ string_size } << 32) | record_size;
+	}
+
+	constexpr uint32_t header_record_size(uint64_t header) noexcept
+	{
+		return static_cast<uint32_t>(header);
+	}
+
+	constexpr uint32_t header_string_size(uint64_t header) noexcept
+	{
+		return static_cast<uint32_t>(header >> 32) & 0xffffff;
+	}
+
+	constexpr uint8_t header_tag(uint64_t header) noexcept
+	{
+		return static_cast<uint8_t>(header >> 56);
+	}
+
+	// A claimer may read a header at a stale position which has been reused by then,
+	// so all writes to the buffer are done by atomic words to avoid data races.
+	void store_words(uint8_t* destination, const void* source, size_t size) noexcept
+	{
+		auto words = reinterpret_cast<uint64_t*>(destination);
+		auto bytes = static_cast<const uint8_t*>(source);
+		for (; size >= sizeof(uint64_t); size -= sizeof(uint64_t), bytes += sizeof(uint64_t))
+		{
+			uint64_t word;
+			std::memcpy(&word, bytes, sizeof word);
+			std::atomic_ref{ *words++ }.store(word, std::memory_order_relaxed);
+		}
+		if (size > 0)
+		{
+			uint64_t word = 0;
+			std::memcpy(&word, bytes, size);
+			std::atomic_ref{ *words }.store(word, std::memory_order_relaxed);
+		}
+	}
+
+	void zero_words(uint8_t* destination, size_t size) noexcept
+	{
+		for (auto words = reinterpret_cast<uint64_t*>(destination); size > 0; size -= sizeof(uint64_t))
+			std::atomic_ref{ *words++ }.store(0, std::memory_order_relaxed);
+	}
 }
 
 namespace Yt
 {
-	bool RingLog::pop(std::string& text)
-	{
-		if (_size == 0)
-			return false;
-		const auto text_offset = (_offset + 1) & OffsetMask;
-		const auto text_size = size_t{ _buffer[_offset] };
-		_offset = (text_offset + text_size) & OffsetMask;
-		assert(_size >= text_size + 1);
-		_size -= text_size + 1;
-		if (const auto continuous_size = _buffer.size() - text_offset; continuous_size < text_size)
+	RingLog::RingLog(size_t capacity, Overflow overflow, std::chrono::nanoseconds block_timeout)
+		: _storage{ std::make_unique<uint64_t[]>(::round_capacity(capacity) / sizeof(uint64_t)) }
+		, _buffer{ reinterpret_cast<uint8_t*>(_storage.get()) }
+		, _mask{ ::round_capacity(capacity) - 1 }
+		, _overflow{ overflow }
+		, _block_timeout{ block_timeout }
+	{
+	}
+
+	std::atomic_ref<uint64_t> RingLog::header_at(uint64_t position) const noexcept
+	{
+		// Headers are accessed atomically from any thread, while the rest of the record belongs to its owner.
+		return std::atomic_ref{ *reinterpret_cast<uint64_t*>(_buffer + (position & _mask)) };
+	}
+
+	bool RingLog::pop(std::string& text, uint8_t& tag)
+	{
+		for (auto position = _claimed.load(std::memory_order_acquire);;)
+		{
+			if (position == _head.load(std::memory_order_acquire))
+				return false;
+			const auto header = header_at(position).load(std::memory_order_acquire);
+			const auto record_size = header_record_size(header);
+			if (!record_size)
+				return false;
+			if (!_claimed.compare_exchange_weak(position, position + record_size, std::memory_order_acq_rel, std::memory_order_acquire))
+				continue; // The record has been dropped by a producer.
+			// The string is copied directly from one or two parts of the buffer.
+			const auto offset = (position + HeaderSize) & _mask;
+			const size_t string_size = header_string_size(header);
+			const auto first_part = std::min(string_size, _mask + 1 - offset);
+			text.assign(reinterpret_cast<const char*>(_buffer + offset), first_part);
+			text.append(reinterpret_cast<const char*>(_buffer), string_size - first_part);
+			tag = header_tag(header);
+			release(position, record_size);
+			return true;
+		}
+	}
+
+	bool RingLog::push(std::string_view text, uint8_t tag) noexcept
+	{
+		const auto string_size = std::min(text.size(), max_string_size());
+		const auto size = record_size(string_size);
+		const auto capacity = _mask + 1;
+		auto position = _head.load(std::memory_order_relaxed);
+		std::chrono::steady_clock::time_point deadline;
+		for (;;)
 		{
-			text.assign(reinterpret_cast<const char*>(_buffer.data() + text_offset), continuous_size);
-			text.append(reinterpret_cast<const char*>(_buffer.data()), text_size - continuous_size);
+			const auto end = position + size;
+			// The position may be stale, so the consumer may have released space past it, making the difference negative.
+			const auto used = static_cast<int64_t>(end - _released.load(std::memory_order_acquire));
+			if (used > static_cast<int64_t>(capacity))
+			{
+				if (_overflow == Overflow::DropOldest)
+					drop_oldest(end);
+				else if (_overflow == Overflow::DropNewest)
+				{
+					count_dropped(string_size);
+					return false;
+				}
+				else
+				{
+					const auto now = std::chrono::steady_clock::now();
+					if (deadline == std::chrono::steady_clock::time_point{})
+						deadline = now + _block_timeout;
+					else if (now >= deadline)
+					{
+						count_dropped(string_size);
+						return false;
+					}
+					std::this_thread::yield();
+				}
+				position = _head.load(std::memory_order_relaxed);
+				continue;
+			}
+			if (_head.compare_exchange_weak(position, end, std::memory_order_relaxed))
+			{
+				update_high_water_mark(static_cast<size_t>(used));
+				break;
+			}
 		}
-		else
-			text.assign(reinterpret_cast<const char*>(_buffer.data() + text_offset), text_size);
+		// Records are aligned to the header size, so the string can only be split at a word boundary.
+		const auto offset = (position + HeaderSize) & _mask;
+		const auto first_part = std::min(string_size, capacity - offset);
+		store_words(_buffer + offset, text.data(), first_part);
+		store_words(_buffer, text.data() + first_part, string_size - first_part);
+		// Sequentially consistent commit lets the consumer check for new strings after announcing that it is going to sleep.
+		header_at(position).store(make_header(size, string_size, tag), std::memory_order_seq_cst);
 		return true;
 	}
 
-	void RingLog::push(std::string_view text) noexcept
+	bool RingLog::ready() const noexcept
 	{
-		const auto text_size = std::min(text.size(), MaxStringSize);
-		while (text_size >= _buffer.size() - _size)
+		const auto position = _claimed.load(std::memory_order_acquire);
+		return position != _head.load(std::memory_order_acquire)
+			&& header_at(position).load(std::memory_order_seq_cst) != 0;
+	}
+
+	void RingLog::count_dropped(size_t string_size) noexcept
+	{
+		_dropped.fetch_add(1, std::memory_order_relaxed);
+		_dropped_bytes.fetch_add(string_size, std::memory_order_relaxed);
+	}
+
+	void RingLog::drop_oldest(uint64_t end) noexcept
+	{
+		auto position = _claimed.load(std::memory_order_acquire);
+		// If there is a claimed record which is being released, its space will become available soon.
+		if (end - position <= _mask + 1)
 		{
-			const auto skip = 1 + size_t{ _buffer[_offset] };
-			_offset = (_offset + skip) & OffsetMask;
-			assert(_size >= skip);
-			_size -= skip;
+			std::this_thread::yield();
+			return;
 		}
-		_buffer[(_offset + _size++) & OffsetMask] = static_cast<uint8_t>(text_size);
-		const auto text_offset = (_offset + _size) & OffsetMask;
-		if (const auto continuous_size = _buffer.size() - text_offset; continuous_size < text_size)
+		const auto header = header_at(position).load(std::memory_order_acquire);
+		const auto record_size = header_record_size(header);
+		if (!record_size)
 		{
-			std::memcpy(_buffer.data() + text_offset, text.data(), continuous_size);
-			std::memcpy(_buffer.data(), text.data() + continuous_size, text_size - continuous_size);
+			std::this_thread::yield(); // The oldest record is still being written.
+			return;
 		}
-		else
-			std::memcpy(_buffer.data() + text_offset, text.data(), text_size);
-		_size += text_size;
-		assert(_size <= _buffer.size());
+		if (!_claimed.compare_exchange_strong(position, position + record_size, std::memory_order_acq_rel, std::memory_order_relaxed))
+			return;
+		count_dropped(header_string_size(header));
+		release(position, record_size);
+	}
+
+	void RingLog::release(uint64_t position, size_t size) noexcept
+	{
+		// Records must be zeroed before reuse so that uncommitted headers read as zero.
+		const auto offset = position & _mask;
+		const auto first_part = std::min(size, _mask + 1 - offset);
+		zero_words(_buffer + offset, first_part);
+		zero_words(_buffer, size - first_part);
+		// Space is released in order, and earlier claimers have only their records to copy.
+		while (_released.load(std::memory_order_acquire) != position)
+			std::this_thread::yield();
+		_released.store(position + size, std::memory_order_release);
+	}
+
+	void RingLog::update_high_water_mark(size_t used) noexcept
+	{
+		for (auto mark = _high_water_mark.load(std::memory_order_relaxed); used > mark;)
+			if (_high_water_mark.compare_exchange_weak(mark, used, std::memory_order_relaxed))
+				break;
 	}
 }
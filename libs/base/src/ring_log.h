@@ -4,26 +4,108 @@
 
 #pragma once
 
-#include <array>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cstdint>
-#include <limits>
+#include <memory>
 #include <string>
 
 namespace Yt
 {
+	// Lock-free ring of strings with multiple producers and a single consumer.
+	//
+	// Strings are stored in records which consist of an 8-byte header and the string padded to 8 bytes.
+	// Headers never cross the end of the buffer, while strings may wrap around it.
+	// Positions grow monotonically, and each record goes through the following stages:
+	// * a producer reserves space for it by advancing the head;
+	// * the producer writes the string and commits the record by storing its header;
+	// * the consumer (or a producer which needs space) claims the record by advancing the claim position;
+	// * the claimer zeroes the record and releases its space in order.
+	// If there is not enough space for a new string, the overflow policy decides which string is dropped.
+	// Each string carries a tag which the owner may use to tell different kinds of records apart.
 	class RingLog
 	{
 	public:
-		static constexpr size_t BufferSize = 4096;
-		static constexpr size_t MaxStringSize = std::numeric_limits<uint8_t>::max();
+		static constexpr size_t DefaultCapacity = size_t{ 1 } << 16;
+		static constexpr size_t MinCapacity = size_t{ 1 } << 12;
+		static constexpr size_t MaxStringSize = (size_t{ 1 } << 24) - 1;
 
-		[[nodiscard]] constexpr bool empty() const noexcept { return !_size; }
-		bool pop(std::string&);
-		void push(std::string_view) noexcept;
+		enum class Overflow
+		{
+			DropOldest, // Drop the oldest committed strings to make space for the new one.
+			DropNewest, // Drop the new string.
+			Block,      // Wait for space, then drop the new string if the timeout expires.
+		};
+
+		// Size of a record in the buffer for a string of the specified size.
+		static constexpr size_t record_size(size_t string_size) noexcept { return (HeaderSize + string_size + HeaderSize - 1) & ~(HeaderSize - 1); }
+
+		// The capacity is rounded up to a power of two not less than MinCapacity.
+		explicit RingLog(size_t capacity = DefaultCapacity, Overflow = Overflow::DropOldest, std::chrono::nanoseconds block_timeout = {});
+
+		// Returns the position up to which all strings have been popped or dropped.
+		uint64_t begin() const noexcept { return _claimed.load(std::memory_order_acquire); }
+
+		// Returns the buffer size in bytes.
+		size_t capacity() const noexcept { return _mask + 1; }
+
+		// Returns the number of strings dropped so far.
+		uint64_t dropped() const noexcept { return _dropped.load(std::memory_order_relaxed); }
+
+		// Returns the total size of strings dropped so far.
+		uint64_t dropped_bytes() const noexcept { return _dropped_bytes.load(std::memory_order_relaxed); }
+
+		// Returns true if there are no reserved strings.
+		bool empty() const noexcept { return begin() == end(); }
+
+		// Returns the position after the last reserved string.
+		uint64_t end() const noexcept { return _head.load(std::memory_order_acquire); }
+
+		// Returns the maximum size of a string which can be pushed without truncation.
+		size_t max_string_size() const noexcept { return std::min(_mask + 1 - HeaderSize, MaxStringSize); }
+
+		// Returns the maximum number of bytes used at once.
+		size_t high_water_mark() const noexcept { return _high_water_mark.load(std::memory_order_relaxed); }
+
+		// Pops the oldest string if it has been committed.
+		bool pop(std::string& text)
+		{
+			uint8_t tag = 0;
+			return pop(text, tag);
+		}
+
+		// Pops the oldest string and its tag if it has been committed.
+		bool pop(std::string& text, uint8_t& tag);
+
+		// Pushes a string, resolving overflows according to the policy.
+		// Strings longer than max_string_size() are truncated.
+		// Returns false if the string has been dropped.
+		bool push(std::string_view text, uint8_t tag = 0) noexcept;
+
+		// Returns true if the oldest string has been committed and can be popped.
+		bool ready() const noexcept;
+
+	private:
+		static constexpr size_t HeaderSize = sizeof(uint64_t);
+
+		void count_dropped(size_t string_size) noexcept;
+		void drop_oldest(uint64_t end) noexcept;
+		std::atomic_ref<uint64_t> header_at(uint64_t position) const noexcept;
+		void release(uint64_t position, size_t size) noexcept;
+		void update_high_water_mark(size_t used) noexcept;
 
 	private:
-		size_t _offset = 0;
-		size_t _size = 0;
-		std::array<uint8_t, BufferSize> _buffer;
+		alignas(64) std::atomic<uint64_t> _head{ 0 };
+		alignas(64) std::atomic<uint64_t> _claimed{ 0 };
+		alignas(64) std::atomic<uint64_t> _released{ 0 };
+		alignas(64) std::atomic<uint64_t> _dropped{ 0 };
+		std::atomic<uint64_t> _dropped_bytes{ 0 };
+		std::atomic<size_t> _high_water_mark{ 0 };
+		alignas(64) const std::unique_ptr<uint64_t[]> _storage;
+		uint8_t* const _buffer;
+		const size_t _mask;
+		const Overflow _overflow;
+		const std::chrono::nanoseconds _block_timeout;
 	};
 }
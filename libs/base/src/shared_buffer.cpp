@@ -0,0 +1,106 @@
+// This file is part of the Yttrium toolkit.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <yttrium/base/shared_buffer.h>
+
+#include <yttrium/base/buffer.h>
+#include <yttrium/base/mapped_buffer.h>
+
+#include <atomic>
+#include <cassert>
+
+namespace Yt
+{
+	struct SharedBuffer::Storage
+	{
+		std::atomic<size_t> _references{ 1 };
+		Buffer _buffer;
+		MappedBuffer _mapping;
+	};
+
+	SharedBuffer::SharedBuffer(Buffer&& buffer)
+	{
+		if (!buffer.size())
+			return;
+		_storage = new Storage;
+		_storage->_buffer = std::move(buffer);
+		buffer = {};
+		_data = _storage->_buffer.data();
+		_size = _storage->_buffer.size();
+	}
+
+	SharedBuffer::SharedBuffer(MappedBuffer&& mapping)
+	{
+		if (!mapping.size())
+			return;
+		_storage = new Storage;
+		_storage->_mapping = std::move(mapping);
+		_data = _storage->_mapping.data();
+		_size = _storage->_mapping.size();
+	}
+
+	SharedBuffer& SharedBuffer::operator=(const SharedBuffer& other) noexcept
+	{
+		if (this != &other)
+		{
+			other.acquire();
+			release();
+			_storage = other._storage;
+			_data = other._data;
+			_size = other._size;
+		}
+		return *this;
+	}
+
+	SharedBuffer& SharedBuffer::operator=(SharedBuffer&& other) noexcept
+	{
+		if (this != &other)
+		{
+			release();
+			_storage = std::exchange(other._storage, nullptr);
+			_data = std::exchange(other._data, nullptr);
+			_size = std::exchange(other._size, 0);
+		}
+		return *this;
+	}
+
+	SharedBuffer SharedBuffer::slice(size_t offset, size_t size) const noexcept
+	{
+		if (offset > _size)
+			offset = _size;
+		if (size > _size - offset)
+			size = _size - offset;
+		SharedBuffer result;
+		if (size > 0)
+		{
+			acquire();
+			result._storage = _storage;
+			result._data = begin() + offset;
+			result._size = size;
+		}
+		return result;
+	}
+
+	size_t SharedBuffer::use_count() const noexcept
+	{
+		return _storage ? _storage->_references.load(std::memory_order_relaxed) : 0;
+	}
+
+	void SharedBuffer::acquire() const noexcept
+	{
+		if (_storage)
+			_storage->_references.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	void SharedBuffer::release() noexcept
+	{
+		if (!_storage)
+			return;
+		if (_storage->_references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			delete _storage;
+		_storage = nullptr;
+		_data = nullptr;
+		_size = 0;
+	}
+}
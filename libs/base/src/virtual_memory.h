@@ -9,7 +9,14 @@
 namespace Yt
 {
 	void* vm_allocate(size_t) noexcept;
+	void* vm_allocate_aligned(size_t, size_t alignment) noexcept;
+	bool vm_commit(void*, size_t) noexcept;
 	void vm_deallocate(void*, size_t) noexcept;
+	void vm_decommit(void*, size_t) noexcept;
 	size_t vm_granularity() noexcept;
+	bool vm_lock(void*, size_t) noexcept;
+	bool vm_populate(void*, size_t) noexcept;
 	void* vm_reallocate(void*, size_t, size_t) noexcept;
+	void* vm_reserve(size_t) noexcept;
+	void vm_use_huge_pages(void*, size_t) noexcept;
 }
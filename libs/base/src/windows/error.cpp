@@ -50,7 +50,7 @@ namespace Yt
 
 	void log_error(const char* function, unsigned long error) noexcept
 	{
-		std::array<char, Logger::MaxMessageSize + 1> buffer;
+		std::array<char, 256> buffer;
 		if (const auto description = ::windows_error_description(error))
 			*fmt::format_to_n(buffer.data(), buffer.size() - 1, "[{}] (0x{:8X}) {}", function, error, description.get()).out = '\0';
 		else
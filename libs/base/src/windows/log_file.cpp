@@ -0,0 +1,79 @@
+// This file is part of the Yttrium toolkit.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "../log_file.h"
+
+#include "error.h"
+
+#include <algorithm>
+#include <string>
+
+#include <windows.h>
+
+namespace Yt
+{
+	void LogFile::close() noexcept
+	{
+		if (_handle != -1 && !::CloseHandle(reinterpret_cast<HANDLE>(_handle)))
+			log_last_error("CloseHandle");
+		_handle = -1;
+		_size = 0;
+	}
+
+	bool LogFile::open(const std::filesystem::path& path) noexcept
+	{
+		close();
+		const auto file = ::CreateFileW(path.c_str(), FILE_APPEND_DATA, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+		{
+			log_last_error("CreateFileW");
+			return false;
+		}
+		if (LARGE_INTEGER size; !::GetFileSizeEx(file, &size))
+			log_last_error("GetFileSizeEx");
+		else
+			_size = static_cast<uint64_t>(size.QuadPart);
+		_handle = reinterpret_cast<intptr_t>(file);
+		return true;
+	}
+
+	bool LogFile::sync() noexcept
+	{
+		if (_handle == -1)
+			return false;
+		if (::FlushFileBuffers(reinterpret_cast<HANDLE>(_handle)))
+			return true;
+		log_last_error("FlushFileBuffers");
+		return false;
+	}
+
+	bool LogFile::write(std::span<const std::string_view> messages)
+	{
+		if (_handle == -1)
+			return false;
+		// There is no gathering write for regular files, so the batch is joined to be written at once.
+		std::string batch;
+		size_t size = 0;
+		for (const auto message : messages)
+			size += message.size() + 1;
+		batch.reserve(size);
+		for (const auto message : messages)
+		{
+			batch.append(message);
+			batch.push_back('\n');
+		}
+		for (std::string_view data = batch; !data.empty();)
+		{
+			DWORD written = 0;
+			if (!::WriteFile(reinterpret_cast<HANDLE>(_handle), data.data(), static_cast<DWORD>(std::min<size_t>(data.size(), MAXDWORD)), &written, nullptr))
+			{
+				log_last_error("WriteFile");
+				return false;
+			}
+			_size += written;
+			data.remove_prefix(written);
+		}
+		return true;
+	}
+}
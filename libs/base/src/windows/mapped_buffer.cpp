@@ -0,0 +1,71 @@
+// This file is part of the Yttrium toolkit.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <yttrium/base/mapped_buffer.h>
+
+#include "error.h"
+
+#include <windows.h>
+
+namespace Yt
+{
+	std::optional<MappedBuffer> MappedBuffer::open(const std::filesystem::path& path, Flags<Hint> hints) noexcept
+	{
+		const auto file = ::CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+			hints & Hint::Sequential ? FILE_FLAG_SEQUENTIAL_SCAN : FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+		{
+			log_last_error("CreateFileW");
+			return {};
+		}
+		std::optional<MappedBuffer> result;
+		if (LARGE_INTEGER size; !::GetFileSizeEx(file, &size))
+			log_last_error("GetFileSizeEx");
+		else if (size.QuadPart == 0)
+			result.emplace(); // Empty files can't be mapped.
+		else if (const auto mapping = ::CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr); !mapping)
+			log_last_error("CreateFileMappingW");
+		else
+		{
+			// The view keeps references to both the mapping and the file.
+			if (const auto data = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0); !data)
+				log_last_error("MapViewOfFile");
+			else
+			{
+				result.emplace();
+				result->_data = data;
+				result->_size = static_cast<size_t>(size.QuadPart);
+				result->advise(hints);
+			}
+			::CloseHandle(mapping);
+		}
+		::CloseHandle(file);
+		return result;
+	}
+
+	MappedBuffer::~MappedBuffer() noexcept
+	{
+		if (_data && !::UnmapViewOfFile(_data))
+			log_last_error("UnmapViewOfFile");
+	}
+
+	MappedBuffer& MappedBuffer::operator=(MappedBuffer&& other) noexcept
+	{
+		if (_data && !::UnmapViewOfFile(_data))
+			log_last_error("UnmapViewOfFile");
+		_data = std::exchange(other._data, nullptr);
+		_size = std::exchange(other._size, 0);
+		return *this;
+	}
+
+	void MappedBuffer::advise(Flags<Hint> hints) const noexcept
+	{
+		// Windows has no per-range sequential access hint, so it is applied only when the file is opened.
+		if (!_data || !(hints & Hint::WillNeed))
+			return;
+		WIN32_MEMORY_RANGE_ENTRY range{ const_cast<void*>(_data), _size };
+		if (!::PrefetchVirtualMemory(::GetCurrentProcess(), 1, &range, 0))
+			log_last_error("PrefetchVirtualMemory");
+	}
+}
@@ -6,6 +6,7 @@
 
 #include "error.h"
 
+#include <cstdint>
 #include <cstring>
 
 #include <windows.h>
@@ -20,12 +21,45 @@ namespace Yt
 		return result;
 	}
 
+	void* vm_allocate_aligned(size_t size, size_t alignment) noexcept
+	{
+		// Windows can't release a part of an allocation, so we find an aligned address
+		// by reserving extra space and then allocate at that address after releasing it.
+		// Another thread may take the address in the meantime, so we retry a few times.
+		for (int attempt = 0; attempt < 4; ++attempt)
+		{
+			const auto reserved = ::VirtualAlloc(nullptr, size + alignment, MEM_RESERVE, PAGE_NOACCESS);
+			if (!reserved)
+				break;
+			const auto address = reinterpret_cast<uintptr_t>(reserved);
+			const auto aligned = reinterpret_cast<void*>((address + alignment - 1) & ~(alignment - 1));
+			::VirtualFree(reserved, 0, MEM_RELEASE);
+			if (const auto result = ::VirtualAlloc(aligned, size, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE))
+				return result;
+		}
+		return vm_allocate(size);
+	}
+
+	bool vm_commit(void* pointer, size_t size) noexcept
+	{
+		if (::VirtualAlloc(pointer, size, MEM_COMMIT, PAGE_READWRITE))
+			return true;
+		log_last_error("VirtualAlloc");
+		return false;
+	}
+
 	void vm_deallocate(void* pointer, size_t) noexcept
 	{
 		if (!::VirtualFree(pointer, 0, MEM_RELEASE))
 			log_last_error("VirtualFree");
 	}
 
+	void vm_decommit(void* pointer, size_t size) noexcept
+	{
+		if (!::VirtualFree(pointer, size, MEM_DECOMMIT))
+			log_last_error("VirtualFree");
+	}
+
 	size_t vm_granularity() noexcept
 	{
 		SYSTEM_INFO system_info;
@@ -33,6 +67,20 @@ namespace Yt
 		return system_info.dwPageSize;
 	}
 
+	bool vm_lock(void* pointer, size_t size) noexcept
+	{
+		if (::VirtualLock(pointer, size))
+			return true;
+		log_last_error("VirtualLock");
+		return false;
+	}
+
+	bool vm_populate(void*, size_t) noexcept
+	{
+		// Windows has no way to populate anonymous memory without touching it.
+		return false;
+	}
+
 	void* vm_reallocate(void* old_pointer, size_t old_size, size_t new_size) noexcept
 	{
 		const auto new_pointer = ::VirtualAlloc(nullptr, new_size, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
@@ -46,4 +94,18 @@ namespace Yt
 		}
 		return new_pointer;
 	}
+
+	void* vm_reserve(size_t size) noexcept
+	{
+		const auto result = ::VirtualAlloc(nullptr, size, MEM_RESERVE, PAGE_NOACCESS);
+		if (!result)
+			log_last_error("VirtualAlloc");
+		return result;
+	}
+
+	void vm_use_huge_pages(void*, size_t) noexcept
+	{
+		// Large pages on Windows require SeLockMemoryPrivilege and can't be requested
+		// for already allocated memory, so the hint is ignored.
+	}
 }
@@ -0,0 +1,88 @@
+// This file is part of the Yttrium toolkit.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <yttrium/base/allocation_tracker.h>
+#include <yttrium/base/buffer.h>
+#include <yttrium/base/logger.h>
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <doctest/doctest.h>
+
+TEST_CASE("allocation_tracker")
+{
+	Yt::AllocationTracker::set_no_allocation_policy(Yt::NoAllocationPolicy::Count);
+	const auto before = Yt::AllocationTracker::counters();
+	{
+		Yt::NoAllocationScope scope{ "test" };
+		Yt::Buffer buffer;
+		CHECK(scope.allocations() == 0);
+		buffer.reserve(1);
+		CHECK(scope.allocations() == 1);
+		buffer.resize(1);
+		CHECK(scope.allocations() == 1);
+		buffer.resize(2 * buffer.capacity());
+		CHECK(scope.allocations() == 2);
+		const auto pointer = std::make_unique<int>(0);
+		CHECK(scope.allocations() == (Yt::AllocationTracker::tracks_new() ? 3 : 2));
+	}
+	const auto after = Yt::AllocationTracker::counters();
+	CHECK(after._buffer_allocations - before._buffer_allocations == 2);
+	if (Yt::AllocationTracker::tracks_new())
+		CHECK(after._heap_allocations - before._heap_allocations >= 1);
+	else
+		CHECK(after._heap_allocations == 0);
+	Yt::AllocationTracker::set_no_allocation_policy(Yt::NoAllocationPolicy::Report);
+}
+
+TEST_CASE("allocation_tracker.policies")
+{
+	std::vector<std::string> messages;
+	std::mutex mutex;
+	Yt::Logger logger{ [&](std::string_view message) {
+		std::scoped_lock lock{ mutex };
+		messages.emplace_back(message);
+	} };
+
+	Yt::AllocationTracker::set_no_allocation_policy(Yt::NoAllocationPolicy::Report);
+	{
+		Yt::NoAllocationScope scope{ "clean" };
+	}
+	{
+		Yt::NoAllocationScope scope{ "dirty" };
+		Yt::Buffer buffer{ 1 };
+		CHECK(scope.allocations() == 1);
+	}
+	Yt::Logger::flush();
+	{
+		std::scoped_lock lock{ mutex };
+		if (Yt::Logger::compiled_in(Yt::LogLevel::Warning))
+		{
+			REQUIRE(messages.size() == 1);
+			CHECK(messages[0] == "1 allocations in no-allocation scope \"dirty\"");
+		}
+		else
+			CHECK(messages.empty());
+		messages.clear();
+	}
+
+	// Allocations outside the scope are allowed, and a scope without allocations neither aborts nor reports.
+	Yt::AllocationTracker::set_no_allocation_policy(Yt::NoAllocationPolicy::Abort);
+	{
+		Yt::Buffer buffer{ 1 };
+		{
+			Yt::NoAllocationScope scope{ "clean" };
+			buffer.resize(buffer.capacity());
+			CHECK(scope.allocations() == 0);
+		}
+		buffer.resize(2 * buffer.capacity());
+	}
+	Yt::AllocationTracker::set_no_allocation_policy(Yt::NoAllocationPolicy::Report);
+	Yt::Logger::flush();
+	std::scoped_lock lock{ mutex };
+	CHECK(messages.empty());
+}
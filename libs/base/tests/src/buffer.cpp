@@ -4,6 +4,11 @@
 
 #include <yttrium/base/buffer.h>
 
+#include <algorithm>
+#include <cstring>
+#include <thread>
+#include <vector>
+
 #include <doctest/doctest.h>
 
 using Yt::Buffer;
@@ -25,6 +30,11 @@ TEST_CASE("buffer")
 	{
 		Buffer buffer{ 1 };
 		CHECK(buffer.size() == 1);
+		CHECK(buffer.capacity() < granularity);
+	}
+	{
+		Buffer buffer{ granularity / 2 + 1 };
+		CHECK(buffer.size() == granularity / 2 + 1);
 		CHECK(buffer.capacity() == granularity);
 	}
 	{
@@ -39,11 +49,44 @@ TEST_CASE("buffer")
 	}
 }
 
+TEST_CASE("buffer.page_aligned")
+{
+	for (const auto size : { size_t{ 0 }, size_t{ 1 }, granularity, granularity + 1 })
+	{
+		Buffer buffer{ size, Buffer::PageAligned{} };
+		CHECK(buffer.size() == size);
+		CHECK(buffer.capacity() >= granularity);
+		CHECK(reinterpret_cast<uintptr_t>(buffer.data()) % granularity == 0);
+	}
+}
+
+TEST_CASE("buffer.small")
+{
+	std::vector<Buffer> buffers;
+	for (size_t size = 1; size < granularity; size = size * 3 / 2 + 1)
+	{
+		auto& buffer = buffers.emplace_back(size);
+		CHECK(buffer.size() == size);
+		CHECK(buffer.capacity() >= size);
+		CHECK(buffer.capacity() < 2 * size + 64);
+		CHECK(reinterpret_cast<uintptr_t>(buffer.data()) % buffer.capacity() == 0);
+		std::memset(buffer.data(), static_cast<int>(size), size);
+	}
+	for (const auto& buffer : buffers)
+		CHECK(std::all_of(buffer.begin(), buffer.end(), [&buffer](uint8_t value) { return value == static_cast<uint8_t>(buffer.size()); }));
+
+	Buffer buffer{ 1 };
+	buffer[0] = 42;
+	buffer.resize(granularity + 1);
+	CHECK(buffer.capacity() == granularity * 2);
+	CHECK(buffer[0] == 42);
+}
+
 TEST_CASE("buffer.try_reserve")
 {
 	Buffer buffer;
 
-	REQUIRE(buffer.try_reserve(1));
+	REQUIRE(buffer.try_reserve(granularity / 2 + 1));
 	CHECK(buffer.size() == 0);
 	CHECK(buffer.capacity() == granularity);
 
@@ -74,8 +117,8 @@ TEST_CASE("buffer.try_reset")
 {
 	Buffer buffer;
 
-	REQUIRE(buffer.try_reset(1));
-	CHECK(buffer.size() == 1);
+	REQUIRE(buffer.try_reset(granularity / 2 + 1));
+	CHECK(buffer.size() == granularity / 2 + 1);
 	CHECK(buffer.capacity() == granularity);
 
 	REQUIRE(buffer.try_reset(granularity + 1));
@@ -87,8 +130,8 @@ TEST_CASE("buffer.try_resize")
 {
 	Buffer buffer;
 
-	REQUIRE(buffer.try_resize(1));
-	CHECK(buffer.size() == 1);
+	REQUIRE(buffer.try_resize(granularity / 2 + 1));
+	CHECK(buffer.size() == granularity / 2 + 1);
 	CHECK(buffer.capacity() == granularity);
 
 	REQUIRE(buffer.try_resize(granularity + 1));
@@ -104,3 +147,119 @@ TEST_CASE("buffer.try_resize")
 		CHECK(buffer.data() == data);
 	}
 }
+
+TEST_CASE("buffer.threads")
+{
+	constexpr size_t thread_count = 4;
+	constexpr size_t buffer_count = 256;
+	std::vector<std::vector<Buffer>> buffers(thread_count);
+	{
+		std::vector<std::thread> threads;
+		for (size_t i = 0; i < thread_count; ++i)
+			threads.emplace_back([&buffers, i] {
+				for (size_t j = 0; j < buffer_count; ++j)
+				{
+					auto& buffer = buffers[i].emplace_back(granularity * (1 + j % 4));
+					std::memset(buffer.data(), static_cast<int>(i), buffer.size());
+				}
+			});
+		for (auto& thread : threads)
+			thread.join();
+	}
+	bool valid = true;
+	for (size_t i = 0; i < thread_count; ++i)
+		for (const auto& buffer : buffers[i])
+			valid = valid && std::all_of(buffer.begin(), buffer.end(), [i](uint8_t value) { return value == i; });
+	CHECK(valid);
+	{
+		// Each thread frees buffers allocated by another thread.
+		std::vector<std::thread> threads;
+		for (size_t i = 0; i < thread_count; ++i)
+			threads.emplace_back([&buffers, i] { buffers[(i + 1) % thread_count].clear(); });
+		for (auto& thread : threads)
+			thread.join();
+	}
+}
+
+TEST_CASE("buffer.reserve_address_space")
+{
+	Buffer buffer{ 1 };
+	buffer[0] = 42;
+
+	buffer.reserve_address_space(granularity * 1024);
+	CHECK(buffer.size() == 1);
+	CHECK(buffer.capacity() == granularity);
+	CHECK(buffer[0] == 42);
+
+	const auto data = buffer.data();
+	for (size_t size = granularity; size <= granularity * 1024; size += granularity)
+	{
+		buffer.resize(size);
+		buffer[size - 1] = 42;
+	}
+	CHECK(buffer.data() == data);
+	CHECK(buffer.capacity() == granularity * 1024);
+
+	buffer.resize(granularity * 1024 + 1);
+	CHECK(buffer.capacity() > granularity * 1024);
+	CHECK(buffer[0] == 42);
+	CHECK(buffer[granularity * 1024 - 1] == 42);
+}
+
+TEST_CASE("buffer.memory_statistics")
+{
+	size_t level = 0;
+	while (size_t{ 1 } << level < granularity)
+		++level;
+	const auto before = Buffer::memory_statistics();
+	{
+		Buffer buffer{ granularity };
+		const auto statistics = Buffer::memory_statistics();
+		CHECK(statistics._levels[level]._allocations == before._levels[level]._allocations + 1);
+		CHECK(statistics._allocated_bytes == before._allocated_bytes + granularity);
+		CHECK(statistics._peak_mapped_bytes >= statistics._mapped_bytes);
+	}
+	std::thread{ [level, &before] {
+		Buffer buffer{ granularity };
+		buffer = {};
+		const auto statistics = Buffer::memory_statistics();
+		CHECK(statistics._levels[level]._allocations == before._levels[level]._allocations + 2);
+		CHECK(statistics._levels[level]._deallocations == before._levels[level]._deallocations + 2);
+	} }.join();
+	const auto after = Buffer::memory_statistics();
+	CHECK(after._levels[level]._allocations == before._levels[level]._allocations + 2);
+	CHECK(after._allocated_bytes == before._allocated_bytes);
+}
+
+TEST_CASE("buffer.hints")
+{
+	{
+		Buffer buffer{ 1 };
+		buffer[0] = 42;
+		buffer.set_hints(Buffer::Hint::Populate);
+		CHECK(buffer[0] == 42);
+		buffer.resize(granularity * 1024);
+		CHECK(buffer[0] == 42);
+	}
+	{
+		constexpr size_t huge_page_size = size_t{ 2 } << 20;
+		Buffer buffer;
+		buffer.set_hints(Buffer::Hint::HugePages);
+		buffer.resize(2 * huge_page_size);
+		CHECK(reinterpret_cast<uintptr_t>(buffer.data()) % huge_page_size == 0);
+		std::memset(buffer.data(), 1, buffer.size());
+	}
+	{
+		using namespace Yt::Operators;
+		Buffer buffer{ 1 };
+		buffer[0] = 42;
+		buffer.reserve_address_space(granularity * 1024);
+		buffer.set_hints(Buffer::Hint::Populate | Buffer::Hint::HugePages);
+		CHECK(buffer[0] == 42);
+		const auto data = buffer.data();
+		buffer.resize(granularity * 1024);
+		CHECK(buffer.data() == data);
+		CHECK(buffer[0] == 42);
+		std::memset(buffer.data(), 1, buffer.size());
+	}
+}
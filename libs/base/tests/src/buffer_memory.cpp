@@ -0,0 +1,258 @@
+// This file is part of the Yttrium toolkit.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "../../src/buffer_memory.h"
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include <doctest/doctest.h>
+
+using Yt::BufferMemory;
+
+TEST_CASE("buffer_memory.coalescing")
+{
+	const auto granularity = BufferMemory::granularity();
+	BufferMemory memory;
+
+	const auto a = memory.allocate(granularity);
+	const auto b = memory.allocate(granularity);
+	REQUIRE(a);
+	REQUIRE(b);
+	CHECK(memory.fragmentation_counters()._chunks == 1);
+
+	memory.deallocate(a, granularity);
+	memory.deallocate(b, granularity);
+	{
+		const auto counters = memory.fragmentation_counters();
+		CHECK(counters._chunks == 1);
+		CHECK(counters._free_blocks[BufferMemory::ChunkLevel] == 1);
+		for (size_t level = 0; level < BufferMemory::ChunkLevel; ++level)
+			CHECK(counters._free_blocks[level] == 0);
+	}
+
+	const auto c = memory.allocate(BufferMemory::MaxSmallBlockSize);
+	const auto d = memory.allocate(BufferMemory::MaxSmallBlockSize);
+	REQUIRE(c);
+	REQUIRE(d);
+	CHECK(memory.fragmentation_counters()._chunks == 1);
+	memory.deallocate(c, BufferMemory::MaxSmallBlockSize);
+	memory.deallocate(d, BufferMemory::MaxSmallBlockSize);
+}
+
+TEST_CASE("buffer_memory.sub_page")
+{
+	const auto granularity = BufferMemory::granularity();
+	CHECK(BufferMemory::capacity_for_size(0) == 0);
+	CHECK(BufferMemory::capacity_for_size(1) == BufferMemory::MinSmallBlockSize);
+	CHECK(BufferMemory::capacity_for_size(BufferMemory::MinSmallBlockSize + 1) == 2 * BufferMemory::MinSmallBlockSize);
+	CHECK(BufferMemory::capacity_for_size(granularity / 2) == granularity / 2);
+	CHECK(BufferMemory::capacity_for_size(granularity / 2 + 1) == granularity);
+
+	BufferMemory memory;
+	std::vector<void*> blocks;
+	for (auto size = BufferMemory::MinSmallBlockSize; size < granularity; size *= 2)
+	{
+		const auto a = memory.allocate(size);
+		const auto b = memory.allocate(size);
+		REQUIRE(a);
+		REQUIRE(b);
+		CHECK(static_cast<std::byte*>(b) - static_cast<std::byte*>(a) == static_cast<ptrdiff_t>(size));
+		blocks.emplace_back(a);
+		blocks.emplace_back(b);
+	}
+	CHECK(memory.fragmentation_counters()._chunks == 1);
+	for (size_t i = 0; i < blocks.size(); ++i)
+		memory.deallocate(blocks[i], BufferMemory::MinSmallBlockSize << (i / 2));
+	const auto counters = memory.fragmentation_counters();
+	CHECK(counters._free_blocks[BufferMemory::ChunkLevel] == 1);
+	for (size_t level = 0; level < BufferMemory::ChunkLevel; ++level)
+		CHECK(counters._free_blocks[level] == 0);
+}
+
+TEST_CASE("buffer_memory.reallocate_in_place")
+{
+	const auto granularity = BufferMemory::granularity();
+	BufferMemory memory;
+
+	auto a = memory.allocate(granularity);
+	REQUIRE(a);
+	static_cast<char*>(a)[0] = 'A';
+
+	// The buddy is free, so the block grows in place.
+	CHECK(memory.reallocate(a, granularity, 4 * granularity, 1) == a);
+	CHECK(memory.fragmentation_counters()._in_place_reallocations == 1);
+
+	// The buddy is allocated, so the data has to move.
+	const auto b = memory.allocate(4 * granularity);
+	REQUIRE(b);
+	const auto c = memory.reallocate(a, 4 * granularity, 8 * granularity, 1);
+	REQUIRE(c);
+	CHECK(c != a);
+	CHECK(static_cast<char*>(c)[0] == 'A');
+	CHECK(memory.fragmentation_counters()._in_place_reallocations == 1);
+
+	memory.deallocate(b, 4 * granularity);
+	memory.deallocate(c, 8 * granularity);
+	CHECK(memory.fragmentation_counters()._free_blocks[BufferMemory::ChunkLevel] == 1);
+}
+
+TEST_CASE("buffer_memory.trim")
+{
+	BufferMemory memory;
+
+	const auto a = memory.allocate(BufferMemory::MaxSmallBlockSize);
+	const auto b = memory.allocate(BufferMemory::MaxSmallBlockSize);
+	const auto c = memory.allocate(BufferMemory::MaxSmallBlockSize);
+	const auto e = memory.allocate(BufferMemory::MaxSmallBlockSize);
+	REQUIRE(a);
+	REQUIRE(b);
+	REQUIRE(c);
+	REQUIRE(e);
+	CHECK(memory.fragmentation_counters()._chunks == 2);
+
+	memory.deallocate(a, BufferMemory::MaxSmallBlockSize);
+	memory.deallocate(b, BufferMemory::MaxSmallBlockSize);
+	CHECK(memory.trim(BufferMemory::TrimPolicy::Decommit) == BufferMemory::ChunkSize);
+	{
+		const auto counters = memory.fragmentation_counters();
+		CHECK(counters._chunks == 2);
+		CHECK(counters._decommitted_chunks == 1);
+	}
+
+	// A decommitted chunk is reused before mapping a new one.
+	const auto d = memory.allocate(BufferMemory::MaxSmallBlockSize);
+	REQUIRE(d);
+	static_cast<char*>(d)[0] = 'D';
+	{
+		const auto counters = memory.fragmentation_counters();
+		CHECK(counters._chunks == 2);
+		CHECK(counters._decommitted_chunks == 0);
+	}
+
+	memory.deallocate(d, BufferMemory::MaxSmallBlockSize);
+	CHECK(memory.trim(BufferMemory::TrimPolicy::Release, BufferMemory::ChunkSize) == 0);
+	CHECK(memory.trim(BufferMemory::TrimPolicy::Release) == BufferMemory::ChunkSize);
+	CHECK(memory.fragmentation_counters()._chunks == 1);
+
+	memory.set_trim_threshold(BufferMemory::TrimPolicy::Release, 0);
+	memory.deallocate(c, BufferMemory::MaxSmallBlockSize);
+	CHECK(memory.fragmentation_counters()._chunks == 1);
+	memory.deallocate(e, BufferMemory::MaxSmallBlockSize);
+	CHECK(memory.fragmentation_counters()._chunks == 0);
+}
+
+TEST_CASE("buffer_memory.trim_decommitted")
+{
+	constexpr auto size = BufferMemory::MaxSmallBlockSize;
+	BufferMemory memory;
+
+	std::array<void*, 6> blocks{};
+	for (auto& block : blocks)
+	{
+		block = memory.allocate(size);
+		REQUIRE(block);
+	}
+	CHECK(memory.fragmentation_counters()._chunks == 3);
+	for (const auto block : blocks)
+		memory.deallocate(block, size);
+	CHECK(memory.trim(BufferMemory::TrimPolicy::Decommit) == 3 * BufferMemory::ChunkSize);
+	{
+		const auto counters = memory.fragmentation_counters();
+		CHECK(counters._chunks == 3);
+		CHECK(counters._decommitted_chunks == 3);
+		CHECK(counters._free_blocks[BufferMemory::ChunkLevel] == 0);
+	}
+
+	// Every decommitted chunk can be reused.
+	for (auto& block : blocks)
+	{
+		block = memory.allocate(size);
+		REQUIRE(block);
+		static_cast<char*>(block)[size - 1] = 'A';
+	}
+	{
+		const auto counters = memory.fragmentation_counters();
+		CHECK(counters._chunks == 3);
+		CHECK(counters._decommitted_chunks == 0);
+	}
+
+	for (const auto block : blocks)
+		memory.deallocate(block, size);
+	CHECK(memory.trim(BufferMemory::TrimPolicy::Decommit, BufferMemory::ChunkSize) == 2 * BufferMemory::ChunkSize);
+	CHECK(memory.trim(BufferMemory::TrimPolicy::Decommit) == BufferMemory::ChunkSize);
+	CHECK(memory.fragmentation_counters()._decommitted_chunks == 3);
+
+	const auto a = memory.allocate(size);
+	REQUIRE(a);
+	CHECK(memory.fragmentation_counters()._decommitted_chunks == 2);
+	memory.deallocate(a, size);
+
+	// Both committed and decommitted chunks are released, but only the committed ones count as trimmed.
+	CHECK(memory.trim(BufferMemory::TrimPolicy::Release) == BufferMemory::ChunkSize);
+	{
+		const auto counters = memory.fragmentation_counters();
+		CHECK(counters._chunks == 0);
+		CHECK(counters._decommitted_chunks == 0);
+	}
+	CHECK(memory.statistics()._mapped_bytes == 0);
+}
+
+TEST_CASE("buffer_memory.statistics")
+{
+	const auto granularity = BufferMemory::granularity();
+	size_t level = 0;
+	while (size_t{ 1 } << level < granularity)
+		++level;
+	constexpr auto large_capacity = 2 * BufferMemory::MaxSmallBlockSize;
+	BufferMemory memory;
+
+	const auto check_free_bytes = [&memory](const Yt::BufferStatistics& statistics) {
+		auto free_bytes = statistics._allocated_bytes;
+		for (const auto& counters : statistics._levels)
+			free_bytes += counters._free_bytes + counters._cached_bytes;
+		CHECK(free_bytes == statistics._mapped_bytes);
+	};
+
+	const auto a = memory.allocate(granularity);
+	const auto b = memory.allocate(large_capacity);
+	REQUIRE(a);
+	REQUIRE(b);
+	{
+		const auto statistics = memory.statistics();
+		CHECK(statistics._mapped_bytes == BufferMemory::ChunkSize + large_capacity);
+		CHECK(statistics._peak_mapped_bytes == statistics._mapped_bytes);
+		CHECK(statistics._allocated_bytes == granularity + large_capacity);
+		CHECK(statistics._large_allocations == 1);
+		CHECK(statistics._large_deallocations == 0);
+		CHECK(statistics._large_bytes == large_capacity);
+		CHECK(statistics._levels[level]._allocations == 1);
+		CHECK(statistics._levels[level]._deallocations == 0);
+		check_free_bytes(statistics);
+	}
+
+	memory.deallocate(a, granularity);
+	memory.deallocate(b, large_capacity);
+	{
+		const auto statistics = memory.statistics();
+		CHECK(statistics._mapped_bytes == BufferMemory::ChunkSize);
+		CHECK(statistics._peak_mapped_bytes == BufferMemory::ChunkSize + large_capacity);
+		CHECK(statistics._allocated_bytes == 0);
+		CHECK(statistics._large_deallocations == 1);
+		CHECK(statistics._large_bytes == 0);
+		CHECK(statistics._levels[level]._deallocations == 1);
+		CHECK(statistics._levels[BufferMemory::ChunkLevel]._free_bytes == BufferMemory::ChunkSize);
+		check_free_bytes(statistics);
+	}
+
+	CHECK(memory.trim(BufferMemory::TrimPolicy::Decommit) == BufferMemory::ChunkSize);
+	{
+		const auto statistics = memory.statistics();
+		CHECK(statistics._mapped_bytes == 0);
+		check_free_bytes(statistics);
+	}
+	memory.trim(BufferMemory::TrimPolicy::Release);
+	CHECK(memory.statistics()._mapped_bytes == 0);
+}
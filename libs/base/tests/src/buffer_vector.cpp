@@ -0,0 +1,109 @@
+// This file is part of the Yttrium toolkit.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <yttrium/base/buffer_vector.h>
+
+#include <array>
+
+#include <doctest/doctest.h>
+
+TEST_CASE("buffer_vector")
+{
+	Yt::BufferVector<uint32_t> v;
+	CHECK(v.empty());
+	CHECK(v.size() == 0);
+	CHECK(v.capacity() == 0);
+	for (uint32_t i = 0; i < 1000; ++i)
+		v.push_back(i);
+	CHECK(v.size() == 1000);
+	CHECK(v.capacity() >= 1000);
+	for (uint32_t i = 0; i < 1000; ++i)
+		CHECK(v[i] == i);
+	v.clear();
+	CHECK(v.empty());
+	CHECK(v.capacity() >= 1000);
+}
+
+TEST_CASE("buffer_vector.append")
+{
+	Yt::BufferVector<uint16_t> v;
+	v.push_back(1);
+	const std::array<uint16_t, 3> values{ 2, 3, 4 };
+	v.append(values);
+	REQUIRE(v.size() == 4);
+	CHECK(v[0] == 1);
+	CHECK(v[1] == 2);
+	CHECK(v[2] == 3);
+	CHECK(v[3] == 4);
+	const auto n = v.emplace_n(2);
+	CHECK(n == v.data() + 4);
+	n[0] = 5;
+	n[1] = 6;
+	CHECK(v.size() == 6);
+	CHECK(v.end() == v.begin() + 6);
+	CHECK(v[5] == 6);
+}
+
+TEST_CASE("buffer_vector.growth")
+{
+	Yt::BufferVector<uint64_t> v;
+	size_t reallocations = 0;
+	auto capacity = v.capacity();
+	for (uint64_t i = 0; i < 1'000'000; ++i)
+	{
+		v.push_back(i);
+		if (v.capacity() != capacity)
+		{
+			CHECK(v.capacity() >= 2 * capacity);
+			capacity = v.capacity();
+			++reallocations;
+		}
+	}
+	CHECK(reallocations < 20);
+	size_t mismatches = 0;
+	for (uint64_t i = 0; i < 1'000'000; ++i)
+		if (v[i] != i)
+			++mismatches;
+	CHECK(mismatches == 0);
+}
+
+TEST_CASE("buffer_vector.release")
+{
+	Yt::BufferVector<uint32_t> v;
+	v.reserve(100);
+	const auto capacity = v.capacity();
+	CHECK(capacity >= 100);
+	for (uint32_t i = 0; i < 100; ++i)
+		v.push_back_unsafe(i);
+	CHECK(v.capacity() == capacity);
+	const auto data = v.data();
+	const auto buffer = v.release();
+	CHECK(v.empty());
+	CHECK(v.capacity() == 0);
+	CHECK(buffer.data() == data);
+	CHECK(buffer.size() == 100 * sizeof(uint32_t));
+
+	Yt::BufferVector<uint32_t> w{ Yt::Buffer{ buffer.size(), buffer.data() } };
+	CHECK(w.size() == 100);
+	CHECK(w[99] == 99);
+	w.push_back(100);
+	CHECK(w.size() == 101);
+	CHECK(w[100] == 100);
+}
+
+TEST_CASE("buffer_vector.move")
+{
+	Yt::BufferVector<uint32_t> v;
+	v.push_back(1);
+	auto w = std::move(v);
+	CHECK(v.empty());
+	CHECK(v.capacity() == 0);
+	REQUIRE(w.size() == 1);
+	CHECK(w[0] == 1);
+	v = std::move(w);
+	CHECK(w.empty());
+	REQUIRE(v.size() == 1);
+	v.push_back(2);
+	CHECK(v[1] == 2);
+}
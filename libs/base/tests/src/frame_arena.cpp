@@ -0,0 +1,73 @@
+// This file is part of the Yttrium toolkit.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <yttrium/base/frame_arena.h>
+
+#include <cstring>
+
+#include <doctest/doctest.h>
+
+using Yt::FrameArena;
+
+TEST_CASE("frame_arena")
+{
+	FrameArena arena;
+	CHECK(arena.capacity() == 0);
+	CHECK(arena.frame() == 0);
+
+	const auto a = arena.allocate(1, 1);
+	const auto b = arena.allocate<uint64_t>(1);
+	REQUIRE(a);
+	REQUIRE(b);
+	CHECK(reinterpret_cast<uintptr_t>(b) % alignof(uint64_t) == 0);
+	CHECK(static_cast<void*>(b) > a);
+	const auto capacity = arena.capacity();
+	CHECK(capacity > 0);
+
+	arena.next_frame();
+	CHECK(arena.frame() == 1);
+	CHECK(arena.allocate(1, 1) == a);
+	CHECK(arena.capacity() == capacity);
+}
+
+TEST_CASE("frame_arena.growth")
+{
+	FrameArena arena;
+	const auto size = Yt::Buffer::memory_granularity();
+	const auto first = static_cast<uint8_t*>(arena.allocate(size));
+	std::memset(first, 1, size);
+	for (int i = 0; i < 4; ++i)
+		std::memset(arena.allocate(size), 2, size);
+	CHECK(first[0] == 1);
+	CHECK(first[size - 1] == 1);
+	CHECK(arena.capacity() >= 5 * size);
+
+	// The next frames fit into a single block.
+	for (int frame = 0; frame < 2; ++frame)
+	{
+		arena.next_frame();
+		const auto capacity = arena.capacity();
+		const auto second = static_cast<uint8_t*>(arena.allocate(size));
+		for (size_t i = 0; i < 4; ++i)
+			CHECK(static_cast<uint8_t*>(arena.allocate(size)) == second + (i + 1) * size);
+		CHECK(arena.capacity() == capacity);
+	}
+}
+
+TEST_CASE("frame_arena.frames")
+{
+	FrameArena arena{ 3 };
+	const auto a = arena.allocate(1);
+	arena.next_frame();
+	const auto b = arena.allocate(1);
+	arena.next_frame();
+	const auto c = arena.allocate(1);
+	CHECK(a != b);
+	CHECK(a != c);
+	CHECK(b != c);
+	arena.next_frame();
+	CHECK(arena.allocate(1) == a);
+	arena.next_frame();
+	CHECK(arena.allocate(1) == b);
+}
@@ -0,0 +1,129 @@
+// This file is part of the Yttrium toolkit.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <yttrium/base/log_sink.h>
+#include <yttrium/base/logger.h>
+
+#include <atomic>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <doctest/doctest.h>
+
+namespace
+{
+	class TestSink final : public Yt::LogSink
+	{
+	public:
+		std::atomic<bool> _blocked{ true };
+		std::vector<std::string> _messages;
+		size_t _batches = 0;
+
+		void write(std::span<const std::string_view> messages) override
+		{
+			while (_blocked.load())
+				std::this_thread::yield();
+			_messages.insert(_messages.end(), messages.begin(), messages.end());
+			++_batches;
+		}
+	};
+
+	struct TemporaryPath
+	{
+		const std::filesystem::path _path;
+
+		explicit TemporaryPath(const char* name)
+			: _path{ std::filesystem::temp_directory_path() / name }
+		{
+			remove();
+		}
+
+		~TemporaryPath() noexcept { remove(); }
+
+		std::filesystem::path rotated(int index) const
+		{
+			auto result = _path;
+			result += '.' + std::to_string(index);
+			return result;
+		}
+
+		void remove() const noexcept
+		{
+			std::error_code error;
+			std::filesystem::remove(_path, error);
+			for (int i = 1; i <= 3; ++i)
+				std::filesystem::remove(rotated(i), error);
+		}
+	};
+
+	std::string read_file(const std::filesystem::path& path)
+	{
+		std::ostringstream stream;
+		stream << std::ifstream{ path, std::ios::binary }.rdbuf();
+		return stream.str();
+	}
+}
+
+TEST_CASE("log_sink.batch")
+{
+	constexpr size_t count = 1000;
+
+	auto sink = std::make_unique<TestSink>();
+	const auto sink_pointer = sink.get();
+	Yt::Logger logger{ std::move(sink) };
+	for (size_t i = 0; i < count; ++i)
+		Yt::Logger::write(std::to_string(i));
+	sink_pointer->_blocked.store(false);
+	Yt::Logger::flush();
+
+	REQUIRE(sink_pointer->_messages.size() == count);
+	size_t errors = 0;
+	for (size_t i = 0; i < count; ++i)
+		if (sink_pointer->_messages[i] != std::to_string(i))
+			++errors;
+	CHECK(errors == 0);
+	CHECK(sink_pointer->_batches < count / 2);
+}
+
+TEST_CASE("log_sink.file")
+{
+	const TemporaryPath file{ "yttrium_log_sink_file" };
+	{
+		auto sink = Yt::LogSink::open_file(file._path, { ._sync = Yt::LogFileSync::Batch });
+		REQUIRE(sink);
+		Yt::Logger logger{ std::move(sink) };
+		Yt::Logger::write("Hello,");
+		Yt::Logger::write("world!");
+	}
+	CHECK(read_file(file._path) == "Hello,\nworld!\n");
+	{
+		Yt::Logger logger{ Yt::LogSink::open_file(file._path) };
+		Yt::Logger::write("Appended");
+	}
+	CHECK(read_file(file._path) == "Hello,\nworld!\nAppended\n");
+
+	CHECK(!Yt::LogSink::open_file(file._path / "file_in_a_file"));
+}
+
+TEST_CASE("log_sink.file.rotation")
+{
+	const TemporaryPath file{ "yttrium_log_sink_rotation" };
+	Yt::LogFileOptions options;
+	options._max_size = 32;
+	options._max_files = 2;
+	options._sync = Yt::LogFileSync::Rotation;
+	Yt::Logger logger{ Yt::LogSink::open_file(file._path, options) };
+	for (char c = 'a'; c <= 'h'; ++c)
+	{
+		Yt::Logger::write(std::string(9, c)); // 10 bytes per line, 3 lines per file.
+		Yt::Logger::flush();
+	}
+	CHECK(read_file(file._path) == "ggggggggg\nhhhhhhhhh\n");
+	CHECK(read_file(file.rotated(1)) == "ddddddddd\neeeeeeeee\nfffffffff\n");
+	CHECK(read_file(file.rotated(2)) == "aaaaaaaaa\nbbbbbbbbb\nccccccccc\n");
+	CHECK(!std::filesystem::exists(file.rotated(3)));
+}
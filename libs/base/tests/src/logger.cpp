@@ -5,6 +5,10 @@
 #include <yttrium/base/logger.h>
 #include "../../src/ring_log.h"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
 #include <mutex>
 #include <thread>
 
@@ -87,26 +91,272 @@ TEST_CASE("logger.flush_on_destruction")
 	}
 }
 
+TEST_CASE("logger.levels")
+{
+	std::vector<std::string> messages;
+	std::mutex mutex;
+
+	Yt::Logger logger{ [&](std::string_view message) {
+		std::scoped_lock lock{ mutex };
+		messages.emplace_back(message);
+	} };
+
+	CHECK(Yt::Logger::enabled(Yt::LogLevel::Debug, Yt::LogCategory::Driver));
+	Yt::Logger::set_level(Yt::LogCategory::Driver, Yt::LogLevel::Warning);
+	CHECK(!Yt::Logger::enabled(Yt::LogLevel::Debug, Yt::LogCategory::Driver));
+	CHECK(!Yt::Logger::enabled(Yt::LogLevel::Info, Yt::LogCategory::Driver));
+	CHECK(Yt::Logger::enabled(Yt::LogLevel::Warning, Yt::LogCategory::Driver));
+	CHECK(Yt::Logger::enabled(Yt::LogLevel::Error, Yt::LogCategory::Driver));
+	CHECK(Yt::Logger::enabled(Yt::LogLevel::Debug, Yt::LogCategory::Renderer));
+	CHECK(Yt::Logger::enabled(Yt::LogLevel::Debug, Yt::LogCategory::Gui));
+
+	// Statements of the levels which aren't compiled in are never evaluated.
+	constexpr int debug = Yt::Logger::compiled_in(Yt::LogLevel::Debug);
+	constexpr int warning = Yt::Logger::compiled_in(Yt::LogLevel::Warning);
+
+	int evaluated = 0;
+	Y_LOG_INFO(Driver, "{}", ++evaluated);
+	Y_LOG_WARNING(Driver, "{}", ++evaluated);
+	Y_LOG_DEBUG(Renderer, "{}", ++evaluated);
+	CHECK(evaluated == warning + debug);
+
+	Yt::Logger::set_level(Yt::LogCategory::Driver, Yt::LogLevel::Debug);
+	CHECK(Yt::Logger::enabled(Yt::LogLevel::Debug, Yt::LogCategory::Driver));
+	Y_LOG_DEBUG(Driver, "{}", ++evaluated);
+	CHECK(evaluated == warning + 2 * debug);
+
+	Yt::Logger::flush();
+	std::scoped_lock lock{ mutex };
+	REQUIRE(messages.size() == static_cast<size_t>(evaluated));
+	for (size_t i = 0; i < messages.size(); ++i)
+		CHECK(messages[i] == std::to_string(i + 1));
+}
+
+TEST_CASE("logger.log")
+{
+	std::vector<std::string> messages;
+	std::mutex mutex;
+
+	Yt::Logger logger{ [&](std::string_view message) {
+		std::scoped_lock lock{ mutex };
+		messages.emplace_back(message);
+	} };
+
+	enum class Enum : uint8_t
+	{
+		Value = 42,
+	};
+
+	std::string string = "original";
+	Yt::Logger::log("{} {} {} {}", -1, 2u, int8_t{ -3 }, Enum::Value);
+	Yt::Logger::log("{} {} {:.2f} {}", true, 'x', 0.125, 1.5f);
+	Yt::Logger::log("[{}] [{}] [{}]", string, std::string_view{ "view" }, "literal");
+	Yt::Logger::log("{1}{0}{{}}", "A", "B");
+	Yt::Logger::log("{}", static_cast<const char*>(nullptr));
+	Yt::Logger::log("{:>4}|{:x}", 7, 255);
+	Yt::Logger::log("{}", std::string(2 * Yt::Logger::MaxCapturedSize, 'z'));
+	Yt::Logger::log("{:d}", "not a number");
+	string = "modified";
+	Yt::Logger::flush();
+
+	std::scoped_lock lock{ mutex };
+	REQUIRE(messages.size() == 8);
+	CHECK(messages[0] == "-1 2 -3 42");
+	CHECK(messages[1] == "true x 0.12 1.5");
+	CHECK(messages[2] == "[original] [view] [literal]");
+	CHECK(messages[3] == "BA{}");
+	CHECK(messages[4] == "");
+	CHECK(messages[5] == "   7|ff");
+	CHECK(messages[6] == std::string(2 * Yt::Logger::MaxCapturedSize, 'z'));
+	CHECK(messages[7].find("{:d}") != std::string::npos);
+}
+
+TEST_CASE("logger.log.long")
+{
+	std::vector<std::string> messages;
+	std::mutex mutex;
+
+	Yt::Logger logger{ [&](std::string_view message) {
+		std::scoped_lock lock{ mutex };
+		messages.emplace_back(message);
+	} };
+
+	std::string string(4096, '.');
+	for (size_t i = 0; i < string.size(); i += 64)
+		string[i] = static_cast<char>('A' + i / 64 % 26);
+	Yt::Logger::log(Yt::LogCategory::Driver, "{}: {} ({})", 1, string, "end");
+	Yt::Logger::log("{}{}", std::string(Yt::Logger::MaxCapturedSize / 2, 'x'), std::string(Yt::Logger::MaxCapturedSize / 2, 'y'));
+	Yt::Logger::flush();
+
+	std::scoped_lock lock{ mutex };
+	REQUIRE(messages.size() == 2);
+	CHECK(messages[0] == "1: " + string + " (end)");
+	CHECK(messages[1] == std::string(Yt::Logger::MaxCapturedSize / 2, 'x') + std::string(Yt::Logger::MaxCapturedSize / 2, 'y'));
+}
+
+TEST_CASE("logger.log.format")
+{
+	static_assert(Yt::Logger::Format<>::check(""));
+	static_assert(Yt::Logger::Format<>::check("{{}}"));
+	static_assert(Yt::Logger::Format<int>::check("{}"));
+	static_assert(Yt::Logger::Format<int>::check("{:08x}"));
+	static_assert(Yt::Logger::Format<int, int>::check("{1} {0} {1}"));
+	static_assert(!Yt::Logger::Format<>::check("{}"));
+	static_assert(!Yt::Logger::Format<>::check("{"));
+	static_assert(!Yt::Logger::Format<>::check("}"));
+	static_assert(!Yt::Logger::Format<int>::check(""));
+	static_assert(!Yt::Logger::Format<int>::check("{} {}"));
+	static_assert(!Yt::Logger::Format<int>::check("{1}"));
+	static_assert(!Yt::Logger::Format<int>::check("{:"));
+	static_assert(!Yt::Logger::Format<int>::check("{:{}}"));
+	static_assert(!Yt::Logger::Format<int, int>::check("{} {1}"));
+	static_assert(!Yt::Logger::Format<int, int>::check("{}"));
+}
+
+TEST_CASE("logger.overflow")
+{
+	std::vector<std::string> messages;
+	std::mutex mutex;
+	std::atomic<bool> blocked{ true };
+
+	Yt::LoggerOptions options;
+	options._capacity = Yt::RingLog::MinCapacity;
+	options._overflow = Yt::LogOverflow::DropNewest;
+	Yt::Logger logger{ [&](std::string_view message) {
+		while (blocked.load())
+			std::this_thread::yield();
+		std::scoped_lock lock{ mutex };
+		messages.emplace_back(message);
+	},
+		options };
+	CHECK(Yt::Logger::statistics()._capacity == Yt::RingLog::MinCapacity);
+
+	constexpr size_t count = 2 * Yt::RingLog::MinCapacity / Yt::RingLog::record_size(1);
+	for (size_t i = 0; i < count; ++i)
+		Yt::Logger::write("x");
+	const auto statistics = Yt::Logger::statistics();
+	CHECK(statistics._dropped_messages > 0);
+	CHECK(statistics._dropped_bytes == statistics._dropped_messages);
+	CHECK(statistics._high_water_mark == Yt::RingLog::MinCapacity);
+	blocked.store(false);
+	Yt::Logger::flush();
+
+	std::scoped_lock lock{ mutex };
+	REQUIRE(messages.size() == count - statistics._dropped_messages + 1);
+	CHECK(std::count(messages.begin(), messages.end(), "x") == static_cast<ptrdiff_t>(count - statistics._dropped_messages));
+	CHECK(std::count(messages.begin(), messages.end(), "(" + std::to_string(statistics._dropped_messages) + " messages dropped)") == 1);
+}
+
+TEST_CASE("logger.long_message")
+{
+	std::string received;
+	Yt::Logger logger{ [&](std::string_view message) { received = message; } };
+
+	std::string message(20'000, '.');
+	for (size_t i = 0; i < message.size(); i += 100)
+		message[i] = static_cast<char>('0' + i / 100 % 10);
+	Yt::Logger::write(message);
+	Yt::Logger::flush();
+	CHECK(received == message);
+}
+
+TEST_CASE("logger.rate_limit")
+{
+	std::vector<std::string> messages;
+	std::mutex mutex;
+
+	Yt::Logger logger{ [&](std::string_view message) {
+		std::scoped_lock lock{ mutex };
+		messages.emplace_back(message);
+	} };
+
+	constexpr int info = Yt::Logger::compiled_in(Yt::LogLevel::Info);
+
+	int evaluated = 0;
+	Yt::Logger::set_rate_limit(Yt::LogCategory::Gui, 2);
+	for (int i = 0; i < 5; ++i)
+	{
+		Y_LOG_INFO(Gui, "{}", ++evaluated);
+		Y_LOG_INFO(Renderer, "{}", -i);
+	}
+	CHECK(evaluated == 2 * info);
+
+	Yt::Logger::set_rate_limit(Yt::LogCategory::Gui, 0);
+	for (int i = 0; i < 5; ++i)
+		Y_LOG_INFO(Gui, "{}", ++evaluated);
+	CHECK(evaluated == 7 * info);
+
+	Yt::Logger::flush();
+	std::scoped_lock lock{ mutex };
+	CHECK(messages.size() == 12 * info);
+	CHECK(std::count(messages.begin(), messages.end(), "1") == info);
+	CHECK(std::count(messages.begin(), messages.end(), "7") == info);
+	CHECK(std::count(messages.begin(), messages.end(), "-4") == info);
+}
+
+TEST_CASE("logger.repeats")
+{
+	std::vector<std::string> messages;
+	std::mutex mutex;
+
+	auto logger = std::make_unique<Yt::Logger>([&](std::string_view message) {
+		std::scoped_lock lock{ mutex };
+		messages.emplace_back(message);
+	});
+
+	Yt::Logger::set_collapse_repeats(Yt::LogCategory::Gui, true);
+	for (int i = 0; i < 4; ++i)
+		Yt::Logger::log(Yt::LogCategory::Gui, "{}", "a");
+	Yt::Logger::write(Yt::LogCategory::Gui, "b");
+	Yt::Logger::write("c");
+	Yt::Logger::write("c");
+	for (int i = 0; i < 3; ++i)
+		Yt::Logger::write(Yt::LogCategory::Gui, "d");
+	logger.reset();
+	Yt::Logger::set_collapse_repeats(Yt::LogCategory::Gui, false);
+
+	std::scoped_lock lock{ mutex };
+	REQUIRE(messages.size() == 7);
+	CHECK(messages[0] == "a");
+	CHECK(messages[1] == "(last message repeated 3 times)");
+	CHECK(messages[2] == "b");
+	CHECK(messages[3] == "c");
+	CHECK(messages[4] == "c");
+	CHECK(messages[5] == "d");
+	CHECK(messages[6] == "(last message repeated 2 times)");
+}
+
 TEST_CASE("logger.ring_log")
 {
-	constexpr size_t buffer_size = Yt::RingLog::BufferSize;
 	constexpr size_t string_size = 251; // A prime number.
 	static_assert(string_size <= Yt::RingLog::MaxStringSize);
-	constexpr size_t max_strings = buffer_size / string_size;
-
 	Yt::RingLog log;
+	REQUIRE(log.capacity() == Yt::RingLog::DefaultCapacity);
+	const size_t max_strings = log.capacity() / Yt::RingLog::record_size(string_size);
+
 	CHECK(log.empty());
+	CHECK(!log.ready());
 
 	std::string string;
 	CHECK(!log.pop(string));
 
+	uint8_t tag = 0;
+	log.push("tagged", 255);
+	CHECK(log.pop(string, tag));
+	CHECK(string == "tagged");
+	CHECK(tag == 255);
+
 	char next = 'A';
 	for (size_t i = 0; i < max_strings + 1; ++i)
 	{
 		log.push(std::string(string_size, next));
 		CHECK(!log.empty());
+		CHECK(log.ready());
 		next = next == 'Z' ? 'A' : static_cast<char>(next + 1);
 	}
+	CHECK(log.dropped() == 1);
+	CHECK(log.dropped_bytes() == string_size);
+	CHECK(log.high_water_mark() <= log.capacity());
 
 	next = 'B';
 	for (size_t i = 0; i < max_strings; ++i)
@@ -119,4 +369,179 @@ TEST_CASE("logger.ring_log")
 
 	CHECK(log.empty());
 	CHECK(!log.pop(string));
+	CHECK(log.begin() == log.end());
+}
+
+TEST_CASE("logger.ring_log.long")
+{
+	Yt::RingLog log{ Yt::RingLog::MinCapacity };
+	REQUIRE(log.max_string_size() == log.capacity() - Yt::RingLog::record_size(0));
+
+	const auto make_string = [](size_t size, size_t seed) {
+		std::string result(size, '\0');
+		for (size_t i = 0; i < size; ++i)
+			result[i] = static_cast<char>(i * 7 + seed);
+		return result;
+	};
+
+	// Strings of coprime sizes wrap around the end of the buffer at different offsets.
+	std::string popped;
+	for (size_t i = 0; i < 64; ++i)
+	{
+		const auto string = make_string(log.max_string_size() / 2 + 1 + i * 13, i);
+		CHECK(log.push(string));
+		CHECK(log.pop(popped));
+		CHECK(popped == string);
+	}
+	CHECK(log.dropped() == 0);
+
+	const auto longest = make_string(log.capacity(), 0);
+	CHECK(log.push(longest));
+	CHECK(log.push(longest)); // Drops the previous string.
+	CHECK(log.dropped() == 1);
+	CHECK(log.pop(popped));
+	CHECK(popped == longest.substr(0, log.max_string_size()));
+	CHECK(log.empty());
+}
+
+TEST_CASE("logger.ring_log.overflow")
+{
+	constexpr size_t string_size = 100;
+	const std::string string(string_size, '.');
+
+	SUBCASE("capacity")
+	{
+		CHECK(Yt::RingLog{ 0 }.capacity() == Yt::RingLog::MinCapacity);
+		CHECK(Yt::RingLog{ Yt::RingLog::MinCapacity + 1 }.capacity() == 2 * Yt::RingLog::MinCapacity);
+	}
+
+	SUBCASE("drop_newest")
+	{
+		Yt::RingLog log{ Yt::RingLog::MinCapacity, Yt::RingLog::Overflow::DropNewest };
+		const auto max_strings = log.capacity() / Yt::RingLog::record_size(string_size);
+		for (size_t i = 0; i < max_strings; ++i)
+			CHECK(log.push(string, static_cast<uint8_t>(i)));
+		CHECK(!log.push(string));
+		CHECK(log.dropped() == 1);
+		CHECK(log.dropped_bytes() == string_size);
+		CHECK(log.high_water_mark() == max_strings * Yt::RingLog::record_size(string_size));
+		CHECK(log.push("x")); // Smaller strings may still fit.
+
+		std::string popped;
+		uint8_t tag = 0;
+		CHECK(log.pop(popped, tag));
+		CHECK(tag == 0);
+		CHECK(log.push(string));
+	}
+
+	SUBCASE("block")
+	{
+		Yt::RingLog log{ Yt::RingLog::MinCapacity, Yt::RingLog::Overflow::Block, std::chrono::milliseconds{ 1 } };
+		const auto max_strings = log.capacity() / Yt::RingLog::record_size(string_size);
+		for (size_t i = 0; i < max_strings; ++i)
+			CHECK(log.push(string));
+		CHECK(!log.push(string)); // Times out.
+		CHECK(log.dropped() == 1);
+
+		std::atomic<bool> done{ false };
+		std::thread consumer{ [&] {
+			std::string popped;
+			while (!done.load() || !log.empty())
+				log.pop(popped);
+		} };
+		for (size_t i = 0; i < 10 * max_strings; ++i)
+			log.push(string);
+		done.store(true);
+		consumer.join();
+		CHECK(log.dropped() < 1 + 10 * max_strings);
+	}
+}
+
+TEST_CASE("logger.ring_log.threads")
+{
+	constexpr size_t thread_count = 4;
+	constexpr uint32_t string_count = 100'000;
+
+	// Each string contains the thread index, then the string index, and has a size specific to the thread.
+	const auto string_size = [](size_t thread) { return 1 + sizeof(uint32_t) + thread * 337; };
+
+	Yt::RingLog log;
+	std::atomic<size_t> finished{ 0 };
+	std::vector<std::thread> threads;
+	for (size_t i = 0; i < thread_count; ++i)
+		threads.emplace_back([&, i] {
+			std::string string(string_size(i), static_cast<char>(i));
+			for (uint32_t j = 0; j < string_count; ++j)
+			{
+				std::memcpy(string.data() + 1, &j, sizeof j);
+				log.push(string);
+			}
+			finished.fetch_add(1);
+		});
+
+	std::array<int64_t, thread_count> last;
+	last.fill(-1);
+	size_t popped = 0;
+	size_t errors = 0;
+	std::string string;
+	while (finished.load() < thread_count || !log.empty())
+	{
+		if (!log.pop(string))
+			continue;
+		++popped;
+		const auto thread = static_cast<size_t>(string[0]);
+		if (thread >= thread_count || string.size() != string_size(thread))
+		{
+			++errors;
+			continue;
+		}
+		uint32_t index = 0;
+		std::memcpy(&index, string.data() + 1, sizeof index);
+		if (index <= last[thread])
+			++errors; // Strings from the same thread must be popped in order.
+		last[thread] = index;
+	}
+	for (auto& thread : threads)
+		thread.join();
+	CHECK(errors == 0);
+	CHECK(popped + log.dropped() == thread_count * string_count);
+}
+
+TEST_CASE("logger.ring_log.threads.no_overflow")
+{
+	constexpr size_t thread_count = 4;
+	constexpr size_t string_count = 100'000;
+	const std::string string(16, '.');
+
+	// The ring is never full, so no strings may be dropped even with stale producer positions.
+	Yt::RingLog log{ Yt::RingLog::MinCapacity, Yt::RingLog::Overflow::DropNewest };
+	const auto max_pending = log.capacity() / Yt::RingLog::record_size(string.size()) - thread_count;
+	std::atomic<size_t> pending{ 0 };
+	std::atomic<size_t> finished{ 0 };
+	std::vector<std::thread> threads;
+	for (size_t i = 0; i < thread_count; ++i)
+		threads.emplace_back([&] {
+			for (size_t j = 0; j < string_count; ++j)
+			{
+				while (pending.load() >= max_pending)
+					std::this_thread::yield();
+				pending.fetch_add(1);
+				log.push(string);
+			}
+			finished.fetch_add(1);
+		});
+
+	size_t popped = 0;
+	std::string popped_string;
+	while (finished.load() < thread_count || !log.empty())
+	{
+		if (!log.pop(popped_string))
+			continue;
+		pending.fetch_sub(1);
+		++popped;
+	}
+	for (auto& thread : threads)
+		thread.join();
+	CHECK(log.dropped() == 0);
+	CHECK(popped == thread_count * string_count);
 }
@@ -0,0 +1,64 @@
+// This file is part of the Yttrium toolkit.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <yttrium/base/mapped_buffer.h>
+
+#include <cstring>
+#include <fstream>
+
+#include <doctest/doctest.h>
+
+namespace
+{
+	struct TemporaryFile
+	{
+		const std::filesystem::path _path;
+
+		TemporaryFile(const char* name, std::string_view contents)
+			: _path{ std::filesystem::temp_directory_path() / name }
+		{
+			std::ofstream{ _path, std::ios::binary }.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+		}
+
+		~TemporaryFile() noexcept
+		{
+			std::error_code error;
+			std::filesystem::remove(_path, error);
+		}
+	};
+}
+
+TEST_CASE("mapped_buffer")
+{
+	using namespace Yt::Operators;
+	const TemporaryFile file{ "yttrium_mapped_buffer", "Hello, world!" };
+	auto mapped = Yt::MappedBuffer::open(file._path, Yt::MappedBuffer::Hint::Sequential | Yt::MappedBuffer::Hint::WillNeed);
+	REQUIRE(mapped);
+	REQUIRE(mapped->size() == 13);
+	CHECK(!std::memcmp(mapped->data(), "Hello, world!", 13));
+	CHECK(mapped->end() == mapped->begin() + 13);
+
+	const auto data = mapped->data();
+	Yt::MappedBuffer moved{ std::move(*mapped) };
+	CHECK(!mapped->data());
+	CHECK(mapped->size() == 0);
+	CHECK(moved.data() == data);
+	*mapped = std::move(moved);
+	CHECK(mapped->data() == data);
+	CHECK(!moved.data());
+}
+
+TEST_CASE("mapped_buffer.empty")
+{
+	const TemporaryFile file{ "yttrium_mapped_buffer_empty", {} };
+	const auto mapped = Yt::MappedBuffer::open(file._path);
+	REQUIRE(mapped);
+	CHECK(!mapped->data());
+	CHECK(mapped->size() == 0);
+}
+
+TEST_CASE("mapped_buffer.missing")
+{
+	CHECK(!Yt::MappedBuffer::open(std::filesystem::temp_directory_path() / "yttrium_mapped_buffer_missing"));
+}
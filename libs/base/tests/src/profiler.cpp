@@ -0,0 +1,105 @@
+// This file is part of the Yttrium toolkit.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <yttrium/base/profiler.h>
+
+#include <string>
+#include <thread>
+
+#include <doctest/doctest.h>
+
+namespace
+{
+	size_t count(const std::string& text, const std::string& pattern)
+	{
+		size_t result = 0;
+		for (auto i = text.find(pattern); i != std::string::npos; i = text.find(pattern, i + pattern.size()))
+			++result;
+		return result;
+	}
+}
+
+TEST_CASE("profiler")
+{
+	Yt::Profiler::clear();
+	CHECK(!Yt::Profiler::enabled());
+	{
+		const Yt::ProfileScope scope{ "disabled" };
+	}
+	Yt::Profiler::set_enabled(true);
+	{
+		const Yt::ProfileScope outer{ "outer" };
+		const Yt::ProfileScope inner{ "inner" };
+	}
+	std::thread{ [] {
+		Yt::Profiler::set_thread_name("worker \"1\"");
+		const Yt::ProfileScope scope{ "thread" };
+	} }.join();
+	Yt::Profiler::set_enabled(false);
+
+	const auto trace = Yt::Profiler::trace();
+	CHECK(trace.starts_with("{\"displayTimeUnit\":\"ns\",\"traceEvents\":["));
+	CHECK(trace.ends_with("]}\n"));
+	CHECK(::count(trace, R"("name":"disabled")") == 0);
+	CHECK(::count(trace, R"("name":"outer","ph":"X")") == 1);
+	CHECK(::count(trace, R"("name":"inner","ph":"X")") == 1);
+	CHECK(::count(trace, R"("name":"thread","ph":"X")") == 1);
+	CHECK(::count(trace, R"("args":{"name":"worker \"1\""})") == 1);
+
+	Yt::Profiler::clear();
+	CHECK(::count(Yt::Profiler::trace(), R"("ph":"X")") == 0);
+}
+
+TEST_CASE("profiler.overflow")
+{
+	Yt::Profiler::clear();
+	Yt::Profiler::set_enabled(true);
+	for (size_t i = 0; i < Yt::Profiler::MaxThreadEvents + 10; ++i)
+	{
+		const Yt::ProfileScope scope{ "event" };
+	}
+	Yt::Profiler::set_enabled(false);
+	CHECK(::count(Yt::Profiler::trace(), R"("name":"event")") == Yt::Profiler::MaxThreadEvents);
+	Yt::Profiler::clear();
+}
+
+TEST_CASE("profiler.threads")
+{
+	Yt::Profiler::clear();
+	Yt::Profiler::set_enabled(true);
+	std::thread thread{ [] {
+		for (size_t i = 0; i < 4 * Yt::Profiler::MaxThreadEvents; ++i)
+		{
+			const Yt::ProfileScope scope{ "busy" };
+		}
+	} };
+	for (int i = 0; i < 10; ++i)
+	{
+		const auto trace = Yt::Profiler::trace();
+		CHECK(::count(trace, R"("name":"busy")") <= Yt::Profiler::MaxThreadEvents);
+		CHECK(::count(trace, "\"ph\":\"X\"") == ::count(trace, "\"dur\":"));
+	}
+	thread.join();
+	Yt::Profiler::set_enabled(false);
+	const auto trace = Yt::Profiler::trace();
+	CHECK(::count(trace, R"("name":"busy")") == Yt::Profiler::MaxThreadEvents);
+	Yt::Profiler::clear();
+}
+
+TEST_CASE("profiler.thread_exit")
+{
+	Yt::Profiler::clear();
+	Yt::Profiler::set_enabled(true);
+	for (int i = 0; i < 3; ++i)
+		std::thread{ [] {
+			Yt::Profiler::set_thread_name("exited");
+			const Yt::ProfileScope scope{ "exited" };
+		} }.join();
+	Yt::Profiler::set_enabled(false);
+	const auto trace = Yt::Profiler::trace();
+	CHECK(::count(trace, R"("name":"exited","ph":"X")") == 3);
+	CHECK(::count(trace, R"("args":{"name":"exited"})") == 3);
+	Yt::Profiler::clear();
+	CHECK(::count(Yt::Profiler::trace(), R"("name":"exited")") == 0);
+}
@@ -0,0 +1,79 @@
+// This file is part of the Yttrium toolkit.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <yttrium/base/buffer.h>
+#include <yttrium/base/shared_buffer.h>
+
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include <doctest/doctest.h>
+
+TEST_CASE("shared_buffer")
+{
+	Yt::SharedBuffer empty;
+	CHECK(!empty.data());
+	CHECK(empty.size() == 0);
+	CHECK(empty.use_count() == 0);
+
+	Yt::Buffer buffer{ 6, "abcdef" };
+	const auto data = buffer.data();
+	Yt::SharedBuffer a{ std::move(buffer) };
+	CHECK(!buffer.data());
+	CHECK(a.data() == data);
+	CHECK(a.size() == 6);
+	CHECK(a.use_count() == 1);
+	{
+		const auto b = a;
+		CHECK(b.data() == data);
+		CHECK(a.use_count() == 2);
+	}
+	CHECK(a.use_count() == 1);
+	auto c = std::move(a);
+	CHECK(!a.data());
+	CHECK(a.use_count() == 0);
+	CHECK(c.use_count() == 1);
+	a = c;
+	CHECK(a.use_count() == 2);
+	const auto& self = a;
+	a = self;
+	CHECK(a.use_count() == 2);
+	a = std::move(c);
+	CHECK(a.use_count() == 1);
+	CHECK(a.data() == data);
+}
+
+TEST_CASE("shared_buffer.slice")
+{
+	Yt::SharedBuffer a{ Yt::Buffer{ 6, "abcdef" } };
+	const auto b = a.slice(1, 3);
+	CHECK(b.size() == 3);
+	CHECK(!std::memcmp(b.data(), "bcd", 3));
+	CHECK(a.use_count() == 2);
+	const auto c = b.slice(2);
+	CHECK(c.size() == 1);
+	CHECK(c.begin() == a.begin() + 3);
+	CHECK(a.use_count() == 3);
+	CHECK(a.slice(4, 10).size() == 2);
+	CHECK(a.slice(10).size() == 0);
+	CHECK(a.slice(10).use_count() == 0);
+	a = {};
+	CHECK(b.use_count() == 2);
+	CHECK(!std::memcmp(c.data(), "d", 1));
+}
+
+TEST_CASE("shared_buffer.threads")
+{
+	const Yt::SharedBuffer a{ Yt::Buffer{ 4, "abcd" } };
+	std::vector<std::thread> threads;
+	for (int i = 0; i < 4; ++i)
+		threads.emplace_back([&a] {
+			for (int j = 0; j < 10'000; ++j)
+				[[maybe_unused]] const auto b = a.slice(1);
+		});
+	for (auto& thread : threads)
+		thread.join();
+	CHECK(a.use_count() == 1);
+}
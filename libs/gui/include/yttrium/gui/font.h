@@ -21,6 +21,7 @@ namespace Yt
 {
 	class RenderManager;
 	class Renderer2D;
+	class SharedBuffer;
 	class Texture2D;
 
 	class Font
@@ -45,6 +46,9 @@ namespace Yt
 
 		static std::shared_ptr<const Font> load(const seir::SharedPtr<seir::Blob>&, RenderManager&);
 
+		/// Loads a font directly from a shared buffer (e.g. a mapped file), keeping a reference to it.
+		static std::shared_ptr<const Font> load(const SharedBuffer&, RenderManager&);
+
 		virtual ~Font() noexcept = default;
 		virtual void render(Renderer2D&, const seir::RectF&, std::string_view) const = 0;
 		virtual float textWidth(std::string_view, float fontSize, TextCapture* = nullptr) const = 0;
@@ -7,6 +7,7 @@
 #include <yttrium/gui/layout.h>
 
 #include <cassert>
+#include <cstring>
 
 namespace Yt
 {
@@ -48,7 +49,9 @@ namespace Yt
 		if (index >= kPayloadMask)
 			return;
 		_inputEvents.reserve(_inputEvents.size() + 1);
-		_textInputs.emplace_back(text);
+		const auto data = _frameArena.allocate<char>(text.size());
+		std::memcpy(data, text.data(), text.size());
+		_textInputs.emplace_back(data, text.size());
 		_inputEvents.emplace_back(static_cast<uint16_t>(kTextFlag | index));
 	}
 }
@@ -5,6 +5,7 @@
 #include <yttrium/application/application.h>
 #include <yttrium/application/event.h>
 #include <yttrium/application/window.h>
+#include <yttrium/base/frame_arena.h>
 #include <yttrium/gui/font.h>
 #include <yttrium/gui/style.h>
 
@@ -228,7 +229,8 @@ namespace Yt
 
 		Window& _window;
 		std::vector<uint16_t> _inputEvents;
-		std::vector<std::string> _textInputs;
+		std::vector<std::string_view> _textInputs; // Stored in the frame arena.
+		FrameArena _frameArena;
 		seir::Vec2 _mouseCursor{ 0, 0 };
 		bool _mouseCursorTaken = false;
 		bool _mouseHoverTaken = false;
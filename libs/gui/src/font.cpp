@@ -5,6 +5,8 @@
 #include <yttrium/gui/font.h>
 
 #include <yttrium/base/exceptions.h>
+#include <yttrium/base/profiler.h>
+#include <yttrium/base/shared_buffer.h>
 #include <yttrium/renderer/2d.h>
 #include <yttrium/renderer/manager.h>
 #include <yttrium/renderer/texture.h>
@@ -18,6 +20,7 @@
 #include <cstring>
 #include <optional>
 #include <unordered_map>
+#include <utility>
 
 #include <ft2build.h>
 #include FT_FREETYPE_H
@@ -41,6 +44,7 @@ namespace Yt
 	{
 		FT_Library _library = nullptr;
 		seir::SharedPtr<seir::Blob> _faceBlob;
+		SharedBuffer _faceBuffer;
 		FT_Face _face = nullptr;
 
 		FreeTypeWrapper()
@@ -58,22 +62,35 @@ namespace Yt
 
 		void load(const seir::SharedPtr<seir::Blob>& blob)
 		{
-			assert(!_face);
 			assert(blob);
-			if (blob->size() > static_cast<size_t>(std::numeric_limits<FT_Long>::max())
-				|| FT_New_Memory_Face(_library, static_cast<const FT_Byte*>(blob->data()), static_cast<FT_Long>(blob->size()), 0, &_face))
-				throw DataError{ "Failed to load font" };
+			load_face(blob->data(), blob->size());
 			_faceBlob = blob;
 		}
+
+		void load(const SharedBuffer& buffer)
+		{
+			load_face(buffer.data(), buffer.size());
+			_faceBuffer = buffer;
+		}
+
+	private:
+		void load_face(const void* data, size_t size)
+		{
+			assert(!_face);
+			if (size > static_cast<size_t>(std::numeric_limits<FT_Long>::max())
+				|| FT_New_Memory_Face(_library, static_cast<const FT_Byte*>(data), static_cast<FT_Long>(size), 0, &_face))
+				throw DataError{ "Failed to load font" };
+		}
 	};
 
 	class FontImpl final : public Font
 	{
 	public:
-		FontImpl(const seir::SharedPtr<seir::Blob>& blob, RenderManager& renderManager, uint32_t size)
+		template <typename Source>
+		FontImpl(Source&& source, RenderManager& renderManager, uint32_t size)
 			: _size{ static_cast<int>(size) }
 		{
-			_freetype.load(blob);
+			_freetype.load(std::forward<Source>(source));
 			_hasKerning = FT_HAS_KERNING(_freetype._face);
 			FT_Set_Pixel_Sizes(_freetype._face, 0, size);
 			const seir::ImageInfo imageInfo{ size * 32, size * 32, seir::PixelFormat::Intensity8 };
@@ -128,6 +145,7 @@ namespace Yt
 
 		void render(Renderer2D& renderer, const seir::RectF& rect, std::string_view text) const override
 		{
+			Y_PROFILE_SCOPE("Font::render");
 			const auto scale = rect.height() / static_cast<float>(_size);
 			int x = 0;
 			auto previous = _glyph.end();
@@ -246,4 +264,9 @@ namespace Yt
 	{
 		return blob ? std::make_shared<FontImpl>(blob, renderManager, 64) : nullptr;
 	}
+
+	std::shared_ptr<const Font> Font::load(const SharedBuffer& buffer, RenderManager& renderManager)
+	{
+		return buffer.data() ? std::make_shared<FontImpl>(buffer, renderManager, 64) : nullptr;
+	}
 }
@@ -4,6 +4,7 @@
 
 #include <yttrium/gui/gui.h>
 
+#include <yttrium/base/allocation_tracker.h>
 #include <yttrium/gui/context.h>
 #include <yttrium/gui/layout.h>
 #include <yttrium/renderer/2d.h>
@@ -51,22 +52,28 @@ namespace Yt
 
 	GuiFrame::~GuiFrame() noexcept
 	{
-		if (_context._mouseItemKey != Key::None && _context.captureClick(_context._mouseItemKey, false, true).second)
 		{
-			_context._mouseItem.clear();
-			_context._mouseItemKey = Key::None;
-		}
-		if (!_context._mouseItemPresent)
-		{
-			_context._mouseItem.clear();
-			_context._mouseItemKey = Key::None;
+			// Per-frame state is reset in place, keeping its capacity for the next frame.
+			Y_NO_ALLOCATIONS("GuiFrame::~GuiFrame");
+			if (_context._mouseItemKey != Key::None && _context.captureClick(_context._mouseItemKey, false, true).second)
+			{
+				_context._mouseItem.clear();
+				_context._mouseItemKey = Key::None;
+			}
+			if (!_context._mouseItemPresent)
+			{
+				_context._mouseItem.clear();
+				_context._mouseItemKey = Key::None;
+			}
+			if (!_context._keyboardItem._present)
+				_context._keyboardItem._id.clear();
+			_context._inputEvents.clear();
+			_context._textInputs.clear();
+			for (auto& keyState : _context._keyStates)
+				keyState &= static_cast<uint8_t>(~GuiContextData::kKeyStateTaken);
 		}
-		if (!_context._keyboardItem._present)
-			_context._keyboardItem._id.clear();
-		_context._inputEvents.clear();
-		_context._textInputs.clear();
-		for (auto& keyState : _context._keyStates)
-			keyState &= static_cast<uint8_t>(~GuiContextData::kKeyStateTaken);
+		// The arena may replace its blocks with a bigger one if the frame didn't fit.
+		_context._frameArena.next_frame();
 	}
 
 	bool GuiFrame::addButton(std::string_view id, std::string_view text, const seir::RectF& rect)
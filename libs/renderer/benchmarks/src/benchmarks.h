@@ -0,0 +1,14 @@
+// This file is part of the Yttrium toolkit.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <string_view>
+
+void benchmark_gui();
+void benchmark_modifiers();
+void benchmark_renderer_2d();
+
+// Adds a result of the current benchmark to the JSON report.
+void report(std::string_view name, double value, std::string_view unit);
@@ -0,0 +1,170 @@
+// This file is part of the Yttrium toolkit.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "benchmarks.h"
+
+#include <yttrium/gui/context.h>
+#include <yttrium/gui/font.h>
+#include <yttrium/gui/gui.h>
+#include <yttrium/gui/layout.h>
+#include <yttrium/renderer/2d.h>
+#include "scene.h"
+
+#include <seir_graphics/point.hpp>
+#include <seir_graphics/rectf.hpp>
+#include <seir_graphics/size.hpp>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace
+{
+	constexpr size_t Columns = 12;
+	constexpr size_t Rows = 32;
+	constexpr size_t CursorPositions = 64;
+
+	// Monospace font which needs no font file, but renders text
+	// the same way as real fonts do, with a textured rectangle per glyph.
+	class BlockFont final : public Yt::Font
+	{
+	public:
+		explicit BlockFont(BenchmarkScene& scene)
+			: _texture{ scene.make_texture(256, 256, 0xff) } {}
+
+		void render(Yt::Renderer2D& renderer, const seir::RectF& rect, std::string_view text) const override
+		{
+			const auto advance = rect.height() * Advance;
+			renderer.setTexture(_texture);
+			for (auto left = rect.left(); const auto c : text)
+			{
+				if (left >= rect.right())
+					break;
+				const auto index = static_cast<uint8_t>(c);
+				renderer.setTextureRect({ { static_cast<float>(index % 16 * 16), static_cast<float>(index / 16 * 16) }, seir::SizeF{ 16, 16 } });
+				renderer.addBorderlessRect({ { left, rect.top() }, seir::SizeF{ std::min(advance, rect.right() - left), rect.height() } });
+				left += advance;
+			}
+		}
+
+		float textWidth(std::string_view text, float fontSize, TextCapture* capture) const override
+		{
+			const auto advance = fontSize * Advance;
+			if (capture)
+			{
+				if (capture->_cursorOffset <= text.size())
+					capture->_cursorPosition.emplace(static_cast<float>(capture->_cursorOffset) * advance);
+				if (capture->_selectionBegin < capture->_selectionEnd && capture->_selectionEnd <= text.size())
+					capture->_selectionRange.emplace(static_cast<float>(capture->_selectionBegin) * advance, static_cast<float>(capture->_selectionEnd) * advance);
+			}
+			return static_cast<float>(text.size()) * advance;
+		}
+
+		std::shared_ptr<const Yt::Texture2D> texture() const noexcept override { return _texture; }
+		seir::RectF textureRect(Graphics) const noexcept override { return { { 0, 0 }, seir::SizeF{ 1, 1 } }; }
+
+	private:
+		static constexpr float Advance = 0.5f;
+		const std::shared_ptr<const Yt::Texture2D> _texture;
+	};
+
+	enum class WidgetType
+	{
+		Button,
+		Edit,
+		HoverArea,
+		Label,
+	};
+
+	struct Widget
+	{
+		WidgetType _type = WidgetType::Label;
+		std::string _id;
+		std::string _text;
+		seir::RectF _rect;
+	};
+
+	std::string make_text(SceneRandom& random)
+	{
+		std::string text(4 + random.next() % 16, ' ');
+		for (auto& c : text)
+			c = static_cast<char>('a' + random.next() % 26);
+		return text;
+	}
+
+	std::vector<Widget> make_widgets(const seir::SizeF& viewport, uint32_t seed)
+	{
+		SceneRandom random{ seed };
+		const seir::SizeF cell{ viewport._width / static_cast<float>(Columns), viewport._height / static_cast<float>(Rows) };
+		std::vector<Widget> widgets;
+		widgets.reserve(Columns * Rows);
+		for (size_t column = 0; column < Columns; ++column)
+			for (size_t row = 0; row < Rows; ++row)
+			{
+				auto& widget = widgets.emplace_back();
+				widget._type = static_cast<WidgetType>(random.next() % 4);
+				widget._id = "widget" + std::to_string(widgets.size());
+				widget._text = ::make_text(random);
+				widget._rect = { { static_cast<float>(column) * cell._width + 2, static_cast<float>(row) * cell._height + 2 }, seir::SizeF{ cell._width - 4, cell._height - 4 } };
+			}
+		return widgets;
+	}
+
+	std::vector<seir::Point> make_cursor_path(const seir::Size& window_size, uint32_t seed)
+	{
+		SceneRandom random{ seed };
+		std::vector<seir::Point> path;
+		path.reserve(CursorPositions);
+		for (size_t i = 0; i < CursorPositions; ++i)
+			path.emplace_back(static_cast<int>(random.next() % static_cast<uint32_t>(window_size._width)), static_cast<int>(random.next() % static_cast<uint32_t>(window_size._height)));
+		return path;
+	}
+}
+
+void benchmark_gui()
+{
+	BenchmarkScene scene;
+	const auto window_size = scene.window().size();
+	Yt::GuiContext gui{ scene.window() };
+	gui.setDefaultFont(std::make_shared<BlockFont>(scene));
+	auto widgets = ::make_widgets(seir::SizeF{ window_size }, 5);
+	std::vector<std::string> labels;
+	SceneRandom random{ 6 };
+	for (size_t i = 0; i < Rows; ++i)
+		labels.emplace_back(::make_text(random));
+	const auto cursor_path = ::make_cursor_path(window_size, 7);
+	size_t frame_index = 0;
+
+	Yt::Renderer2D renderer{ scene.viewport(), &scene.viewport().frame_arena() };
+	BenchmarkScene::print_header();
+	scene.measure("widgets", [&](Yt::RenderPass& pass) {
+		scene.window().set_cursor(cursor_path[frame_index++ % cursor_path.size()]);
+		{
+			Yt::GuiFrame frame{ gui, renderer };
+			for (auto& widget : widgets)
+			{
+				switch (widget._type)
+				{
+				case WidgetType::Button: frame.addButton(widget._id, widget._text, widget._rect); break;
+				case WidgetType::Edit: frame.addStringEdit(widget._id, widget._text, widget._rect); break;
+				case WidgetType::HoverArea: frame.addHoverArea(widget._rect); break;
+				case WidgetType::Label: frame.addLabel(widget._text, Yt::GuiAlignment::Left, widget._rect); break;
+				}
+			}
+		}
+		renderer.draw(pass);
+	});
+	scene.measure("layout", [&](Yt::RenderPass& pass) {
+		{
+			Yt::GuiFrame frame{ gui, renderer };
+			Yt::GuiLayout layout{ frame };
+			layout.fromTopLeft(Yt::GuiLayout::Axis::Y, 8);
+			layout.setSize({ 240, 24 });
+			layout.setSpacing(4);
+			for (const auto& label : labels)
+				frame.addLabel(label);
+		}
+		renderer.draw(pass);
+	});
+}
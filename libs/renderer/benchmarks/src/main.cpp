@@ -0,0 +1,107 @@
+// This file is part of the Yttrium toolkit.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "benchmarks.h"
+
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+	struct Benchmark
+	{
+		std::string_view _name;
+		void (*_function)();
+	};
+
+	constexpr Benchmark Benchmarks[]{
+		{ "gui", benchmark_gui },
+		{ "modifiers", benchmark_modifiers },
+		{ "renderer_2d", benchmark_renderer_2d },
+	};
+
+	struct Result
+	{
+		std::string_view _benchmark;
+		std::string _name;
+		double _value;
+		std::string_view _unit;
+	};
+
+	std::string_view _current_benchmark;
+	std::vector<Result> _results;
+
+	void write_json_string(std::FILE* file, std::string_view string)
+	{
+		std::fputc('"', file);
+		for (const auto c : string)
+		{
+			if (c == '"' || c == '\\')
+				std::fputc('\\', file);
+			std::fputc(c, file);
+		}
+		std::fputc('"', file);
+	}
+
+	bool write_json(const char* path)
+	{
+		const auto file = std::fopen(path, "w");
+		if (!file)
+			return false;
+		std::fprintf(file, "{\n\t\"results\": [");
+		for (auto i = _results.begin(); i != _results.end(); ++i)
+		{
+			std::fprintf(file, "%s\n\t\t{ \"benchmark\": ", i == _results.begin() ? "" : ",");
+			write_json_string(file, i->_benchmark);
+			std::fprintf(file, ", \"name\": ");
+			write_json_string(file, i->_name);
+			std::fprintf(file, ", \"value\": %.6g, \"unit\": ", i->_value);
+			write_json_string(file, i->_unit);
+			std::fprintf(file, " }");
+		}
+		std::fprintf(file, "\n\t]\n}\n");
+		return std::fclose(file) == 0;
+	}
+}
+
+void report(std::string_view name, double value, std::string_view unit)
+{
+	_results.push_back({ _current_benchmark, std::string{ name }, value, unit });
+}
+
+// Runs the benchmarks specified on the command line, or all of them if none are specified.
+// With --json=<path>, also writes the results to the specified file.
+// With the null renderer (neither YTTRIUM_RENDERER_OPENGL nor YTTRIUM_RENDERER_VULKAN), runs without a display or a GPU.
+int main(int argc, char** argv)
+{
+	constexpr std::string_view json_option = "--json=";
+	const char* json_path = nullptr;
+	std::vector<std::string_view> names;
+	for (int i = 1; i < argc; ++i)
+	{
+		if (const std::string_view argument = argv[i]; argument.starts_with(json_option))
+			json_path = argv[i] + json_option.size();
+		else
+			names.emplace_back(argument);
+	}
+	for (const auto& benchmark : Benchmarks)
+	{
+		bool selected = names.empty();
+		for (auto i = names.begin(); i != names.end() && !selected; ++i)
+			selected = benchmark._name == *i;
+		if (!selected)
+			continue;
+		std::printf("[%s]\n", benchmark._name.data());
+		_current_benchmark = benchmark._name;
+		benchmark._function();
+		std::printf("\n");
+	}
+	if (json_path && !write_json(json_path))
+	{
+		std::fprintf(stderr, "Unable to write %s\n", json_path);
+		return 1;
+	}
+}
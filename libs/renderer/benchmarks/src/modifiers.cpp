@@ -0,0 +1,95 @@
+// This file is part of the Yttrium toolkit.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "benchmarks.h"
+
+#include <yttrium/renderer/manager.h>
+#include <yttrium/renderer/mesh.h>
+#include <yttrium/renderer/modifiers.h>
+#include <yttrium/renderer/pass.h>
+#include <yttrium/renderer/program.h>
+#include "scene.h"
+
+#include <seir_graphics/size.hpp>
+#include <seir_math/mat.hpp>
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+namespace
+{
+	constexpr size_t ObjectCount = 1'000;
+	constexpr size_t MaxDepth = 4;
+	constexpr size_t ProgramCount = 4;
+	constexpr size_t TextureCount = 8;
+
+	// An object drawn under a stack of transformations with its own program and texture.
+	struct Object
+	{
+		std::array<seir::Mat4, MaxDepth> _transformations;
+		size_t _depth = 0;
+		size_t _program = 0;
+		size_t _texture = 0;
+	};
+
+	std::vector<Object> make_objects(uint32_t seed)
+	{
+		SceneRandom random{ seed };
+		std::vector<Object> objects(ObjectCount);
+		for (auto& object : objects)
+		{
+			object._depth = 1 + random.next() % MaxDepth;
+			for (size_t i = 0; i < object._depth; ++i)
+				object._transformations[i] = seir::Mat4::translation({ random.uniform(-10, 10), random.uniform(-10, 10), random.uniform(-10, 10) });
+			object._program = random.next() % ProgramCount;
+			object._texture = random.next() % TextureCount;
+		}
+		return objects;
+	}
+
+	void draw_object(Yt::RenderPass& pass, const Yt::Mesh& mesh, const Object& object, size_t level)
+	{
+		if (level == object._depth)
+		{
+			pass.draw_mesh(mesh);
+			return;
+		}
+		Yt::PushTransformation transformation{ pass, object._transformations[level] };
+		::draw_object(pass, mesh, object, level + 1);
+	}
+}
+
+void benchmark_modifiers()
+{
+	BenchmarkScene scene;
+	const auto window_size = scene.window().size();
+	std::array<std::unique_ptr<Yt::RenderProgram>, ProgramCount> programs;
+	for (auto& program : programs)
+		program = scene.viewport().render_manager().create_program({}, {});
+	std::array<std::shared_ptr<const Yt::Texture2D>, TextureCount> textures;
+	for (size_t i = 0; i < TextureCount; ++i)
+		textures[i] = scene.make_texture(256, 256, static_cast<uint8_t>(0x80 + i * 0x10));
+	const auto mesh = scene.make_mesh(12);
+	const auto random_objects = ::make_objects(4);
+	auto sorted_objects = random_objects;
+	std::stable_sort(sorted_objects.begin(), sorted_objects.end(), [](const Object& a, const Object& b) {
+		return a._program < b._program || (a._program == b._program && a._texture < b._texture);
+	});
+
+	const auto draw_objects = [&](const std::vector<Object>& objects) {
+		return [&](Yt::RenderPass& pass) {
+			Yt::Push3D projection{ pass, seir::Mat4::projection2D(static_cast<float>(window_size._width), static_cast<float>(window_size._height)), seir::Mat4::identity() };
+			for (const auto& object : objects)
+			{
+				Yt::PushProgram program{ pass, programs[object._program].get() };
+				Yt::PushTexture texture{ pass, textures[object._texture].get(), Yt::Texture2D::TrilinearFilter };
+				::draw_object(pass, *mesh, object, 0);
+			}
+		};
+	};
+	BenchmarkScene::print_header();
+	scene.measure("random_state", draw_objects(random_objects));
+	scene.measure("sorted_state", draw_objects(sorted_objects));
+}
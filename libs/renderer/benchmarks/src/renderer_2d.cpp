@@ -0,0 +1,126 @@
+// This file is part of the Yttrium toolkit.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "benchmarks.h"
+
+#include <yttrium/renderer/2d.h>
+#include <yttrium/renderer/texture.h>
+#include "scene.h"
+
+#include <seir_graphics/color.hpp>
+#include <seir_graphics/marginsf.hpp>
+#include <seir_graphics/quadf.hpp>
+#include <seir_graphics/rectf.hpp>
+#include <seir_graphics/size.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
+namespace
+{
+	constexpr size_t TextureCount = 8;
+
+	struct Sprite
+	{
+		seir::RectF _rect;
+		seir::Rgba32 _color;
+		size_t _texture = 0;
+	};
+
+	std::vector<Sprite> make_sprites(size_t count, const seir::SizeF& viewport, float min_size, float max_size, uint32_t seed)
+	{
+		SceneRandom random{ seed };
+		std::vector<Sprite> sprites;
+		sprites.reserve(count);
+		for (size_t i = 0; i < count; ++i)
+		{
+			const seir::SizeF size{ random.uniform(min_size, max_size), random.uniform(min_size, max_size) };
+			const seir::Vec2 position{ random.uniform(0, viewport._width - size._width), random.uniform(0, viewport._height - size._height) };
+			const auto color = random.next();
+			sprites.push_back({
+				seir::RectF{ position, size },
+				seir::Rgba32{ static_cast<uint8_t>(color), static_cast<uint8_t>(color >> 8), static_cast<uint8_t>(color >> 16), static_cast<uint8_t>(color >> 24 | 0x80) },
+				random.next() % TextureCount,
+			});
+		}
+		return sprites;
+	}
+
+	std::vector<seir::QuadF> make_quads(const std::vector<Sprite>& sprites, uint32_t seed)
+	{
+		SceneRandom random{ seed };
+		std::vector<seir::QuadF> quads;
+		quads.reserve(sprites.size());
+		for (const auto& sprite : sprites)
+		{
+			const auto angle = random.uniform(0, 6.2831853f);
+			const auto half_width = sprite._rect.width() / 2;
+			const auto half_height = sprite._rect.height() / 2;
+			const auto center = sprite._rect.topLeft() + seir::Vec2{ half_width, half_height };
+			const seir::Vec2 x{ std::cos(angle) * half_width, std::sin(angle) * half_width };
+			const seir::Vec2 y{ -std::sin(angle) * half_height, std::cos(angle) * half_height };
+			quads.emplace_back(center - x - y, center + x - y, center + x + y, center - x + y);
+		}
+		return quads;
+	}
+}
+
+void benchmark_renderer_2d()
+{
+	BenchmarkScene scene;
+	const seir::SizeF viewport{ scene.window().size() };
+	std::array<std::shared_ptr<const Yt::Texture2D>, TextureCount> textures;
+	for (size_t i = 0; i < TextureCount; ++i)
+		textures[i] = scene.make_texture(256, 256, static_cast<uint8_t>(0x80 + i * 0x10));
+	const auto frame_texture = scene.make_texture(64, 64, 0xff);
+	const auto small_sprites = ::make_sprites(10'000, viewport, 4, 64, 1);
+	const auto large_sprites = ::make_sprites(2'000, viewport, 32, 256, 2);
+	const auto quads = ::make_quads(small_sprites, 3);
+	auto sorted_sprites = large_sprites;
+	std::stable_sort(sorted_sprites.begin(), sorted_sprites.end(), [](const Sprite& a, const Sprite& b) { return a._texture < b._texture; });
+
+	Yt::Renderer2D renderer{ scene.viewport(), &scene.viewport().frame_arena() };
+	BenchmarkScene::print_header();
+	scene.measure("rects", [&](Yt::RenderPass& pass) {
+		for (const auto& sprite : small_sprites)
+		{
+			renderer.setColor(sprite._color);
+			renderer.addRect(sprite._rect);
+		}
+		renderer.draw(pass);
+	});
+	scene.measure("nine_slice", [&](Yt::RenderPass& pass) {
+		renderer.setTexture(frame_texture);
+		renderer.setTextureRect({ { 0, 0 }, seir::SizeF{ 64, 64 } }, { 16, 16, 16, 16 });
+		for (const auto& sprite : large_sprites)
+		{
+			renderer.setColor(sprite._color);
+			renderer.addRect(sprite._rect);
+		}
+		renderer.draw(pass);
+	});
+	scene.measure("quads", [&](Yt::RenderPass& pass) {
+		for (size_t i = 0; i < quads.size(); ++i)
+		{
+			renderer.setColor(small_sprites[i]._color);
+			renderer.addQuad(quads[i]);
+		}
+		renderer.draw(pass);
+	});
+	const auto textured = [&renderer, &textures](const std::vector<Sprite>& sprites) {
+		return [&renderer, &textures, &sprites](Yt::RenderPass& pass) {
+			for (const auto& sprite : sprites)
+			{
+				renderer.setTexture(textures[sprite._texture]);
+				renderer.setColor(sprite._color);
+				renderer.addRect(sprite._rect);
+			}
+			renderer.draw(pass);
+		};
+	};
+	scene.measure("texture_switches", textured(large_sprites));
+	scene.measure("texture_batches", textured(sorted_sprites));
+}
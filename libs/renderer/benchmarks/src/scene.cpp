@@ -0,0 +1,80 @@
+// This file is part of the Yttrium toolkit.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "scene.h"
+
+#include <yttrium/base/allocation_tracker.h>
+#include <yttrium/base/buffer.h>
+#include <yttrium/base/shared_buffer.h>
+#include <yttrium/renderer/manager.h>
+#include <yttrium/renderer/mesh.h>
+#include <yttrium/renderer/texture.h>
+#include "benchmarks.h"
+
+#include <seir_image/image.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+BenchmarkScene::BenchmarkScene()
+{
+	_window.show();
+}
+
+std::unique_ptr<Yt::Mesh> BenchmarkScene::make_mesh(size_t triangles)
+{
+	std::string obj;
+	for (size_t i = 0; i < triangles; ++i)
+	{
+		const auto x = std::to_string(static_cast<float>(i)) + ' ';
+		obj += "v " + x + "0.0 0.0\nv " + x + "1.0 0.0\nv " + x + "0.0 1.0\n";
+	}
+	for (size_t i = 0; i < triangles; ++i)
+		obj += "f " + std::to_string(3 * i + 1) + ' ' + std::to_string(3 * i + 2) + ' ' + std::to_string(3 * i + 3) + '\n';
+	return _viewport.render_manager().load_mesh(Yt::SharedBuffer{ Yt::Buffer{ obj.size(), obj.data() } }, "benchmark.obj");
+}
+
+std::shared_ptr<const Yt::Texture2D> BenchmarkScene::make_texture(uint32_t width, uint32_t height, uint8_t value)
+{
+	const seir::ImageInfo info{ width, height, seir::PixelFormat::Bgra32 };
+	seir::Buffer buffer{ info.frameSize() };
+	std::memset(buffer.data(), value, info.frameSize());
+	return _viewport.render_manager().create_texture_2d({ info, std::move(buffer) });
+}
+
+void BenchmarkScene::measure(std::string_view name, const std::function<void(Yt::RenderPass&)>& callback)
+{
+	for (size_t i = 0; i < WarmupFrames; ++i)
+		_viewport.render(callback);
+	Yt::RenderMetrics total;
+	const auto start = std::chrono::steady_clock::now();
+	for (size_t i = 0; i < MeasuredFrames; ++i)
+	{
+		_viewport.render(callback);
+		total += _viewport.metrics();
+	}
+	const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	constexpr auto frames = static_cast<double>(MeasuredFrames);
+	const auto frame_ns = seconds * 1e9 / frames;
+	const auto p99_ns = static_cast<double>(_viewport.frame_time_statistics()._p99._total.count());
+	const auto vertices_per_second = static_cast<double>(total._2d_vertices) / seconds;
+	const auto draw_calls = static_cast<double>(total._draw_calls) / frames;
+	const auto allocations = static_cast<double>(total._cpu_allocations) / frames;
+	const std::string prefix{ name };
+	std::printf("%-20s  %10.0f  %10.0f  %9.2f  %7.1f  %7.1f\n", prefix.c_str(), frame_ns, p99_ns, vertices_per_second / 1e6, draw_calls, allocations);
+	report(prefix + "/frame", frame_ns, "ns");
+	report(prefix + "/frame_p99", p99_ns, "ns");
+	report(prefix + "/vertices", vertices_per_second, "vertices/s");
+	report(prefix + "/draw_calls", draw_calls, "calls/frame");
+	report(prefix + "/allocations", allocations, "allocations/frame");
+}
+
+void BenchmarkScene::print_header()
+{
+	if (!Yt::AllocationTracker::tracks_new())
+		std::printf("Only Buffer allocations are counted, configure with YTTRIUM_TRACK_NEW=ON to count operator new too.\n");
+	std::printf("%-20s  %10s  %10s  %9s  %7s  %7s\n", "scene", "ns/frame", "p99 ns", "Mvert/s", "draws", "allocs");
+}
@@ -0,0 +1,77 @@
+// This file is part of the Yttrium toolkit.
+// Copyright (C) Sergei Blagodarin.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <yttrium/application/application.h>
+#include <yttrium/application/window.h>
+#include <yttrium/renderer/metrics.h>
+#include <yttrium/renderer/viewport.h>
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string_view>
+
+namespace Yt
+{
+	class Mesh;
+	class RenderPass;
+	class Texture2D;
+}
+
+// Xorshift generator which produces the same synthetic scenes on every platform.
+class SceneRandom
+{
+public:
+	explicit constexpr SceneRandom(uint32_t seed) noexcept
+		: _state{ seed } {}
+
+	constexpr uint32_t next() noexcept
+	{
+		_state ^= _state << 13;
+		_state ^= _state >> 17;
+		_state ^= _state << 5;
+		return _state;
+	}
+
+	constexpr float uniform(float min, float max) noexcept
+	{
+		return min + (max - min) * static_cast<float>(next() >> 8) / static_cast<float>(1u << 24);
+	}
+
+private:
+	uint32_t _state;
+};
+
+// Window, viewport and resources for rendering synthetic scenes.
+class BenchmarkScene
+{
+public:
+	static constexpr size_t WarmupFrames = 16;
+	static constexpr size_t MeasuredFrames = Yt::FrameTimeStatistics::MaxFrames; // The statistics cover only measured frames.
+
+	BenchmarkScene();
+
+	// Creates a mesh with the specified number of triangles.
+	std::unique_ptr<Yt::Mesh> make_mesh(size_t triangles);
+
+	// Creates a texture of the specified size filled with a single color.
+	std::shared_ptr<const Yt::Texture2D> make_texture(uint32_t width, uint32_t height, uint8_t value);
+
+	// Renders the warmup frames, then measures the CPU time, the Renderer2D vertex rate
+	// and the allocations of the rendering thread and prints and reports them under the specified name.
+	void measure(std::string_view name, const std::function<void(Yt::RenderPass&)>&);
+
+	Yt::Viewport& viewport() noexcept { return _viewport; }
+	Yt::Window& window() noexcept { return _window; }
+
+	// Prints the header of the table the measure() results are printed in.
+	static void print_header();
+
+private:
+	Yt::Application _application;
+	Yt::Window _window{ _application };
+	Yt::Viewport _viewport{ _window };
+};
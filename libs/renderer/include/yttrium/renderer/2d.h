@@ -20,6 +20,7 @@ namespace seir
 
 namespace Yt
 {
+	class FrameArena;
 	class RenderPass;
 	class Texture2D;
 	class Viewport;
@@ -27,7 +28,9 @@ namespace Yt
 	class Renderer2D
 	{
 	public:
-		explicit Renderer2D(Viewport&);
+		// Vertex data is stored in the frame arena if one is specified,
+		// in which case it must be drawn before the arena finishes the frame.
+		explicit Renderer2D(Viewport&, FrameArena* = nullptr);
 		~Renderer2D() noexcept;
 
 		void addQuad(const seir::QuadF&);
@@ -8,17 +8,20 @@
 
 #include <memory>
 #include <string>
+#include <string_view>
 
 namespace seir
 {
 	class Blob;
 	class Image;
+	class ImageInfo;
 }
 
 namespace Yt
 {
 	class Mesh;
 	class RenderProgram;
+	class SharedBuffer;
 	class Texture2D;
 
 	///
@@ -41,7 +44,14 @@ namespace Yt
 		///
 		virtual std::unique_ptr<Texture2D> create_texture_2d(const seir::Image&, Flags<TextureFlag> = {}) = 0;
 
+		/// Creates a texture from pixel data in a shared buffer (e.g. a slice of a mapped file).
+		/// BGRA pixels are uploaded directly from the buffer, other formats are converted first.
+		virtual std::unique_ptr<Texture2D> create_texture_2d(const seir::ImageInfo&, const SharedBuffer&, Flags<TextureFlag> = {}) = 0;
+
 		///
 		virtual std::unique_ptr<Mesh> load_mesh(const seir::Blob&, std::string_view source_name) = 0;
+
+		/// Loads a mesh directly from a shared buffer (e.g. a mapped file).
+		virtual std::unique_ptr<Mesh> load_mesh(const SharedBuffer&, std::string_view source_name) = 0;
 	};
 }
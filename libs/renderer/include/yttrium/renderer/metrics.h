@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <cstddef>
 
 namespace Yt
@@ -14,9 +15,17 @@ namespace Yt
 		size_t _triangles = 0;              // Triangles per frame.
 		size_t _draw_calls = 0;             // Draw calls per frame.
 		size_t _texture_switches = 0;       // Texture switches per frame.
-		size_t _extra_texture_switches = 0; // Switches to textures already used for the frame (debug only).
+		size_t _extra_texture_switches = 0; // Switches to textures already used for the frame.
 		size_t _shader_switches = 0;        // Shader switches per frame.
-		size_t _extra_shader_switches = 0;  // Switches to shaders already used for the frame (debug only).
+		size_t _extra_shader_switches = 0;  // Switches to shaders already used for the frame.
+		size_t _2d_parts = 0;               // Renderer2D parts (one draw call each) per frame.
+		size_t _2d_vertices = 0;            // Renderer2D vertices per frame.
+		size_t _uploaded_bytes = 0;         // Vertex, index and texture data uploaded since the previous frame.
+		size_t _buffer_reallocations = 0;   // GPU buffers reallocated to fit more data since the previous frame.
+		size_t _cpu_allocations = 0;        // Heap allocations on the rendering thread since the previous frame.
+
+		/// Returns the average number of vertices in a Renderer2D draw call.
+		constexpr size_t vertices_per_2d_draw() const noexcept { return _2d_parts ? _2d_vertices / _2d_parts : 0; }
 
 		constexpr RenderMetrics& operator+=(const RenderMetrics& other) noexcept
 		{
@@ -26,6 +35,11 @@ namespace Yt
 			_extra_texture_switches += other._extra_texture_switches;
 			_shader_switches += other._shader_switches;
 			_extra_shader_switches += other._extra_shader_switches;
+			_2d_parts += other._2d_parts;
+			_2d_vertices += other._2d_vertices;
+			_uploaded_bytes += other._uploaded_bytes;
+			_buffer_reallocations += other._buffer_reallocations;
+			_cpu_allocations += other._cpu_allocations;
 			return *this;
 		}
 	};
@@ -39,6 +53,36 @@ namespace Yt
 			(metrics._extra_texture_switches + frames - 1) / frames,
 			(metrics._shader_switches + frames - 1) / frames,
 			(metrics._extra_shader_switches + frames - 1) / frames,
+			(metrics._2d_parts + frames - 1) / frames,
+			(metrics._2d_vertices + frames - 1) / frames,
+			(metrics._uploaded_bytes + frames - 1) / frames,
+			(metrics._buffer_reallocations + frames - 1) / frames,
+			(metrics._cpu_allocations + frames - 1) / frames,
 		};
 	}
+
+	/// CPU time spent in the phases of a frame.
+	class FrameTimings
+	{
+	public:
+		std::chrono::nanoseconds _interval{ 0 };   // Time since the previous frame started (zero for the first frame).
+		std::chrono::nanoseconds _callback{ 0 };   // Render callback, excluding the backend submission.
+		std::chrono::nanoseconds _submission{ 0 }; // Backend calls made by the render pass.
+		std::chrono::nanoseconds _present{ 0 };    // Buffer swapping, including waiting for presentation.
+		std::chrono::nanoseconds _total{ 0 };      // Whole Viewport::render call.
+	};
+
+	/// Frame time distribution over the recent frames.
+	class FrameTimeStatistics
+	{
+	public:
+		static constexpr size_t MaxFrames = 256; // Number of recent frames the statistics are collected for.
+
+		size_t _frames = 0;                    // Number of frames the statistics are collected for.
+		FrameTimings _p50;                     // Median of each phase.
+		FrameTimings _p95;                     // 95th percentile of each phase.
+		FrameTimings _p99;                     // 99th percentile of each phase.
+		FrameTimings _max;                     // Maximum of each phase.
+		std::chrono::nanoseconds _jitter{ 0 }; // Mean absolute difference between consecutive frame intervals.
+	};
 }
@@ -6,6 +6,7 @@
 
 #include <functional>
 #include <memory>
+#include <span>
 
 namespace seir
 {
@@ -14,6 +15,9 @@ namespace seir
 
 namespace Yt
 {
+	class FrameArena;
+	class FrameTimeStatistics;
+	class FrameTimings;
 	class RenderManager;
 	class RenderMetrics;
 	class RenderPass;
@@ -26,8 +30,23 @@ namespace Yt
 		explicit Viewport(Window&);
 		~Viewport() noexcept;
 
+		/// Returns the arena for transient data of the frames being rendered.
+		/// The arena finishes a frame at the end of render() and keeps the data for one more frame.
+		FrameArena& frame_arena() noexcept;
+
+		/// Returns the timing statistics of the recent frames.
+		FrameTimeStatistics frame_time_statistics() const noexcept;
+
+		/// Returns the timings of the last frame.
+		FrameTimings frame_timings() const noexcept;
+
+		/// Returns the metrics of the last frame.
 		RenderMetrics metrics() const noexcept;
 
+		/// Copies the metrics of up to FrameTimeStatistics::MaxFrames recent frames, from the oldest to the newest.
+		/// Returns the number of frames copied, which is limited by the size of the output span.
+		size_t metrics_history(std::span<RenderMetrics>) const noexcept;
+
 		///
 		void render(const std::function<void(RenderPass&)>&);
 
@@ -5,6 +5,8 @@
 #include <yttrium/renderer/2d.h>
 
 #include <yttrium/base/buffer.h>
+#include <yttrium/base/frame_arena.h>
+#include <yttrium/base/profiler.h>
 #include <yttrium/renderer/modifiers.h>
 #include <yttrium/renderer/program.h>
 #include <yttrium/renderer/viewport.h>
@@ -17,23 +19,84 @@
 #include <seir_graphics/rectf.hpp>
 #include <seir_math/mat.hpp>
 
+#include <algorithm>
 #include <cassert>
+#include <cstring>
+#include <limits>
+#include <span>
 
 namespace Yt
 {
+	// Vertex or index data of a Renderer2D part which is stored
+	// either in a buffer that persists between frames or in a frame arena.
+	template <typename T>
+	class Renderer2DStream
+	{
+	public:
+		T* data() const noexcept { return _data; }
+		T* end() const noexcept { return _data + _size; }
+		size_t size() const noexcept { return _size; }
+		std::span<const T> span() const noexcept { return { _data, _size }; }
+
+		void clear() noexcept { _size = 0; }
+
+		void grow(size_t count) noexcept
+		{
+			assert(_size + count <= _capacity);
+			_size += count;
+		}
+
+		void reserve(size_t capacity, FrameArena* arena)
+		{
+			if (arena && _frame != arena->frame())
+			{
+				// The data from a previous frame is no longer valid.
+				assert(_size == 0);
+				_data = nullptr;
+				_capacity = 0;
+				_frame = arena->frame();
+			}
+			if (capacity <= _capacity)
+				return;
+			if (arena)
+			{
+				const auto new_capacity = std::max(capacity, 2 * _capacity);
+				const auto new_data = arena->allocate<T>(new_capacity);
+				if (_size > 0)
+					std::memcpy(new_data, _data, _size * sizeof(T));
+				_data = new_data;
+				_capacity = new_capacity;
+			}
+			else
+			{
+				_buffer.reserve(capacity * sizeof(T));
+				_data = reinterpret_cast<T*>(_buffer.data());
+				_capacity = _buffer.capacity() / sizeof(T);
+			}
+		}
+
+	private:
+		Buffer _buffer;
+		T* _data = nullptr;
+		size_t _size = 0;
+		size_t _capacity = 0;
+		uint64_t _frame = 0;
+	};
+
 	struct Renderer2DData
 	{
 		struct Part
 		{
 			std::shared_ptr<const Texture2D> _texture;
-			Buffer _vertices;
-			Buffer _indices;
+			Renderer2DStream<Vertex2D> _vertices;
+			Renderer2DStream<uint16_t> _indices;
 
 			explicit Part(const std::shared_ptr<const Texture2D>& texture) noexcept
 				: _texture{ texture } {}
 		};
 
 		const ViewportData& _viewportData;
+		FrameArena* const _arena;
 		std::vector<Part> _parts;
 		Part* _currentPart = nullptr;
 		seir::Rgba32 _color = seir::Rgba32::white();
@@ -47,8 +110,9 @@ namespace Yt
 			size_t _baseIndex = 0;
 		};
 
-		explicit Renderer2DData(const ViewportData& viewportData)
+		Renderer2DData(const ViewportData& viewportData, FrameArena* arena)
 			: _viewportData{ viewportData }
+			, _arena{ arena }
 			, _currentPart{ &_parts.emplace_back(_viewportData._renderer_builtin._white_texture) }
 		{
 			_textureRect = static_cast<const BackendTexture2D*>(_currentPart->_texture.get())->full_rectangle();
@@ -139,20 +203,19 @@ namespace Yt
 
 		Batch prepareBatch(size_t vertexCount, size_t indexCount)
 		{
-			auto nextIndex = _currentPart->_vertices.size() / sizeof(Vertex2D);
+			auto nextIndex = _currentPart->_vertices.size();
 			if (nextIndex > std::numeric_limits<uint16_t>::max() - vertexCount)
 			{
 				advancePart(_currentPart->_texture);
 				nextIndex = 0;
 			}
-			const auto vertexBufferSize = _currentPart->_vertices.size() + sizeof(Vertex2D) * vertexCount;
-			const auto indexBufferSize = _currentPart->_indices.size() + sizeof(uint16_t) * (indexCount + (nextIndex > 0 ? 2 : 0));
-			_currentPart->_vertices.reserve(vertexBufferSize);
-			_currentPart->_indices.reserve(indexBufferSize);
-			auto* const vertices = reinterpret_cast<Vertex2D*>(_currentPart->_vertices.end());
-			auto* indices = reinterpret_cast<uint16_t*>(_currentPart->_indices.end());
-			_currentPart->_vertices.resize(vertexBufferSize);
-			_currentPart->_indices.resize(indexBufferSize);
+			const auto extraIndexCount = indexCount + (nextIndex > 0 ? 2 : 0);
+			_currentPart->_vertices.reserve(_currentPart->_vertices.size() + vertexCount, _arena);
+			_currentPart->_indices.reserve(_currentPart->_indices.size() + extraIndexCount, _arena);
+			auto* const vertices = _currentPart->_vertices.end();
+			auto* indices = _currentPart->_indices.end();
+			_currentPart->_vertices.grow(vertexCount);
+			_currentPart->_indices.grow(extraIndexCount);
 			if (nextIndex > 0)
 			{
 				*indices++ = static_cast<uint16_t>(nextIndex - 1);
@@ -188,8 +251,8 @@ namespace Yt
 		}
 	};
 
-	Renderer2D::Renderer2D(Viewport& viewport)
-		: _data{ std::make_unique<Renderer2DData>(*viewport._data) }
+	Renderer2D::Renderer2D(Viewport& viewport, FrameArena* arena)
+		: _data{ std::make_unique<Renderer2DData>(*viewport._data, arena) }
 	{
 	}
 
@@ -238,6 +301,7 @@ namespace Yt
 
 	void Renderer2D::draw(RenderPass& pass)
 	{
+		Y_PROFILE_SCOPE("Renderer2D::draw");
 		PushProgram program{ pass, _data->_viewportData._renderer_builtin._program_2d.get() };
 		const auto viewport_size = pass.viewport_rect().size();
 		_data->_viewportData._renderer_builtin._program_2d->set_uniform("mvp", seir::Mat4::projection2D(viewport_size._width, viewport_size._height));
@@ -246,10 +310,10 @@ namespace Yt
 			if (part._vertices.size() > 0)
 			{
 				assert(part._indices.size() > 0);
-				assert(part._vertices.size() / sizeof(Vertex2D) <= size_t{ std::numeric_limits<uint16_t>::max() } + 1);
+				assert(part._vertices.size() <= size_t{ std::numeric_limits<uint16_t>::max() } + 1);
 				{
 					PushTexture texture{ pass, part._texture.get(), Texture2D::TrilinearFilter };
-					static_cast<RenderPassImpl&>(pass).flush_2d(part._vertices, part._indices);
+					static_cast<RenderPassImpl&>(pass).flush_2d(part._vertices.span(), part._indices.span());
 				}
 				part._vertices.clear();
 				part._indices.clear();
@@ -270,8 +334,8 @@ namespace Yt
 		assert(partIndex <= static_cast<size_t>(_data->_currentPart - _data->_parts.data()));
 		auto& vertexBuffer = _data->_parts[partIndex]._vertices;
 		const auto vertexIndex = id & 0xffff;
-		assert(vertexIndex + 4 <= vertexBuffer.size() / sizeof(Vertex2D));
-		auto* const vertices = static_cast<Vertex2D*>(vertexBuffer.data()) + vertexIndex;
+		assert(vertexIndex + 4 <= vertexBuffer.size());
+		auto* const vertices = vertexBuffer.data() + vertexIndex;
 		vertices[0]._position = rect.topLeft();
 		vertices[1]._position = rect.bottomLeft();
 		vertices[2]._position = rect.topRight();
@@ -6,6 +6,9 @@
 
 #include <yttrium/renderer/manager.h>
 #include <yttrium/renderer/texture.h>
+#include "../2d.h"
+
+#include <span>
 
 namespace seir
 {
@@ -17,9 +20,15 @@ namespace seir
 
 namespace Yt
 {
-	class Buffer;
 	class MeshData;
 
+	// Backend activity accumulated over its lifetime.
+	struct RenderBackendCounters
+	{
+		size_t _uploaded_bytes = 0;
+		size_t _buffer_reallocations = 0;
+	};
+
 	class RenderBackend
 	{
 	public:
@@ -31,11 +40,16 @@ namespace Yt
 		virtual std::unique_ptr<RenderProgram> create_program(const std::string& vertex_shader, const std::string& fragment_shader) = 0;
 		virtual std::unique_ptr<Texture2D> create_texture_2d(const seir::ImageInfo&, const void*, Flags<RenderManager::TextureFlag>) = 0;
 		virtual size_t draw_mesh(const Mesh&) = 0;
-		virtual void flush_2d(const Buffer& vertices, const Buffer& indices) noexcept = 0;
+		virtual void flush_2d(std::span<const Vertex2D> vertices, std::span<const uint16_t> indices) noexcept = 0;
 		virtual seir::RectF map_rect(const seir::RectF&, seir::ImageAxes) const = 0;
 		virtual void set_program(const RenderProgram*) = 0;
 		virtual void set_texture(const Texture2D&, Flags<Texture2D::Filter>) = 0;
 		virtual void set_viewport_size(const seir::Size&) = 0;
 		virtual seir::Image take_screenshot(const seir::Size&) const = 0;
+
+		RenderBackendCounters counters() const noexcept { return _counters; }
+
+	protected:
+		RenderBackendCounters _counters;
 	};
 }
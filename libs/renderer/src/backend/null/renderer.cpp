@@ -8,6 +8,7 @@
 #include "../../texture.h"
 
 #include <seir_image/image.hpp>
+#include <seir_math/mat.hpp>
 
 namespace Yt
 {
@@ -15,7 +16,7 @@ namespace Yt
 	{
 		struct NullProgram : RenderProgram
 		{
-			void set_uniform(const std::string&, const Matrix4&) override {}
+			void set_uniform(const std::string&, const seir::Mat4&) override {}
 		};
 		return std::make_unique<NullProgram>();
 	}
@@ -26,9 +27,9 @@ namespace Yt
 		return std::make_unique<BackendTexture2D>(*this, info, has_mipmaps);
 	}
 
-	seir::Image NullRenderer::take_screenshot(const Size& viewport_size) const
+	seir::Image NullRenderer::take_screenshot(const seir::Size& viewport_size) const
 	{
-		const seir::ImageInfo info{ width, height, seir::PixelFormat::Rgb24, seir::ImageAxes::XRightYDown };
+		const seir::ImageInfo info{ static_cast<uint32_t>(viewport_size._width), static_cast<uint32_t>(viewport_size._height), seir::PixelFormat::Rgb24, seir::ImageAxes::XRightYDown };
 		seir::Buffer buffer{ info.frameSize() };
 		return seir::Image{ info, std::move(buffer) };
 	}
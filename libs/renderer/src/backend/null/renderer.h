@@ -4,10 +4,11 @@
 
 #pragma once
 
-#include <yttrium/geometry/rect.h>
 #include <yttrium/renderer/mesh.h>
 #include "../backend.h"
 
+#include <seir_graphics/rectf.hpp>
+
 namespace Yt
 {
 	struct WindowID;
@@ -23,11 +24,11 @@ namespace Yt
 		std::unique_ptr<RenderProgram> create_program(const std::string&, const std::string&) override;
 		std::unique_ptr<Texture2D> create_texture_2d(const seir::ImageInfo&, const void*, Flags<RenderManager::TextureFlag>) override;
 		size_t draw_mesh(const Mesh&) override { return 0; }
-		void flush_2d(const Buffer&, const Buffer&) noexcept override {}
-		RectF map_rect(const RectF& rect, ImageOrientation) const override { return rect; }
+		void flush_2d(std::span<const Vertex2D>, std::span<const uint16_t>) noexcept override {}
+		seir::RectF map_rect(const seir::RectF& rect, seir::ImageAxes) const override { return rect; }
 		void set_program(const RenderProgram*) override {}
 		void set_texture(const Texture2D&, Flags<Texture2D::Filter>) override {}
-		void set_viewport_size(const Size&) override {}
-		seir::Image take_screenshot(const Size&) const override;
+		void set_viewport_size(const seir::Size&) override {}
+		seir::Image take_screenshot(const seir::Size&) const override;
 	};
 }
@@ -11,8 +11,6 @@
 #include <algorithm>
 #include <cassert>
 
-#include <fmt/format.h>
-
 namespace Yt
 {
 	GlApi::GlApi()
@@ -24,18 +22,18 @@ namespace Yt
 		assert(MAJOR_VERSION >= Gl::required_major
 			|| (MAJOR_VERSION == Gl::required_major && MINOR_VERSION < Gl::required_minor));
 
-		Logger::write("OpenGL information:");
-		Logger::write(fmt::format("  GL_VERSION = \"{}\"", VERSION));
-		Logger::write(fmt::format("  GL_RENDERER = \"{}\"", RENDERER));
-		Logger::write(fmt::format("  GL_VENDOR = \"{}\"", VENDOR));
-		Logger::write(fmt::format("  GL_MAX_3D_TEXTURE_SIZE = {}", MAX_3D_TEXTURE_SIZE));
-		Logger::write(fmt::format("  GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS = {}", MAX_COMBINED_TEXTURE_IMAGE_UNITS));
-		Logger::write(fmt::format("  GL_MAX_ELEMENTS_INDICES = {}", MAX_ELEMENTS_INDICES));
-		Logger::write(fmt::format("  GL_MAX_ELEMENTS_VERTICES = {}", MAX_ELEMENTS_VERTICES));
+		Y_LOG_INFO(Driver, "OpenGL information:");
+		Y_LOG_INFO(Driver, "  GL_VERSION = \"{}\"", VERSION);
+		Y_LOG_INFO(Driver, "  GL_RENDERER = \"{}\"", RENDERER);
+		Y_LOG_INFO(Driver, "  GL_VENDOR = \"{}\"", VENDOR);
+		Y_LOG_INFO(Driver, "  GL_MAX_3D_TEXTURE_SIZE = {}", MAX_3D_TEXTURE_SIZE);
+		Y_LOG_INFO(Driver, "  GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS = {}", MAX_COMBINED_TEXTURE_IMAGE_UNITS);
+		Y_LOG_INFO(Driver, "  GL_MAX_ELEMENTS_INDICES = {}", MAX_ELEMENTS_INDICES);
+		Y_LOG_INFO(Driver, "  GL_MAX_ELEMENTS_VERTICES = {}", MAX_ELEMENTS_VERTICES);
 		if (EXT_texture_filter_anisotropic)
-			Logger::write(fmt::format("  GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT = {}", MAX_TEXTURE_MAX_ANISOTROPY_EXT));
-		Logger::write(fmt::format("  GL_MAX_TEXTURE_SIZE = {}", MAX_TEXTURE_SIZE));
-		Logger::write(fmt::format("  GL_MAX_VIEWPORT_DIMS = ( {}, {} )", MAX_VIEWPORT_DIMS[0], MAX_VIEWPORT_DIMS[1]));
+			Y_LOG_INFO(Driver, "  GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT = {}", MAX_TEXTURE_MAX_ANISOTROPY_EXT);
+		Y_LOG_INFO(Driver, "  GL_MAX_TEXTURE_SIZE = {}", MAX_TEXTURE_SIZE);
+		Y_LOG_INFO(Driver, "  GL_MAX_VIEWPORT_DIMS = ( {}, {} )", MAX_VIEWPORT_DIMS[0], MAX_VIEWPORT_DIMS[1]);
 
 		if (!ARB_vertex_attrib_binding)
 			throw InitializationError{ "GL_ARB_vertex_attrib_binding is unavailable" };
@@ -5,6 +5,7 @@
 #include "renderer.h"
 
 #include <yttrium/base/logger.h>
+#include <yttrium/base/profiler.h>
 #include "../../2d.h"
 #include "../../model/mesh_data.h"
 #include "mesh.h"
@@ -16,11 +17,11 @@
 #include <seir_image/image.hpp>
 #include <seir_image/utils.hpp>
 
+#include <algorithm>
 #include <cassert>
 
 #ifndef NDEBUG
 #	include <csignal>
-#	include <fmt/format.h>
 #endif
 
 namespace
@@ -107,7 +108,8 @@ namespace Yt
 		}
 
 		GlBufferHandle vertex_buffer(_gl, GL_ARRAY_BUFFER);
-		vertex_buffer.initialize(GL_STATIC_DRAW, data._vertex_data.size(), data._vertex_data.data());
+		vertex_buffer.initialize(GL_STATIC_DRAW, data._vertex_data.size_bytes(), data._vertex_data.data());
+		_counters._uploaded_bytes += data._vertex_data.size_bytes();
 		vertex_array.bind_vertex_buffer(0, vertex_buffer.get(), 0, offset);
 
 		GlBufferHandle index_buffer(_gl, GL_ELEMENT_ARRAY_BUFFER);
@@ -116,9 +118,13 @@ namespace Yt
 		{
 			index_buffer.initialize(GL_STATIC_DRAW, index_data.size(), index_data.data());
 			index_format = GL_UNSIGNED_SHORT;
+			_counters._uploaded_bytes += index_data.size();
 		}
 		else
-			index_buffer.initialize(GL_STATIC_DRAW, data._indices.size() * sizeof(uint32_t), data._indices.data());
+		{
+			index_buffer.initialize(GL_STATIC_DRAW, data._indices.size_bytes(), data._indices.data());
+			_counters._uploaded_bytes += data._indices.size_bytes();
+		}
 
 		return std::make_unique<OpenGLMesh>(std::move(vertex_array), std::move(vertex_buffer), std::move(index_buffer), static_cast<GLsizei>(data._indices.size()), index_format);
 	}
@@ -152,6 +158,7 @@ namespace Yt
 			GlTextureHandle texture{ _gl, GL_TEXTURE_2D };
 			_gl.PixelStorei(GL_PACK_ALIGNMENT, static_cast<GLint>(alignment));
 			texture.set_data(0, GL_RGBA8, static_cast<GLsizei>(info.width()), static_cast<GLsizei>(info.height()), GL_BGRA, GL_UNSIGNED_BYTE, data);
+			_counters._uploaded_bytes += info.frameSize();
 			const auto has_mipmaps = !(flags & RenderManager::TextureFlag::NoMipmaps);
 			if (has_mipmaps)
 				texture.generate_mipmaps();
@@ -189,21 +196,28 @@ namespace Yt
 		return static_cast<size_t>(opengl_mesh._index_buffer_size / 3);
 	}
 
-	void GlRenderer::flush_2d(const Buffer& vertices, const Buffer& indices) noexcept
+	void GlRenderer::flush_2d(std::span<const Vertex2D> vertices, std::span<const uint16_t> indices) noexcept
 	{
-		if (vertices.capacity() > _2d_vbo.size())
-			_2d_vbo.initialize(GL_DYNAMIC_DRAW, vertices.capacity(), vertices.data());
-		else
-			_2d_vbo.write(0, vertices.size(), vertices.data());
+		Y_PROFILE_SCOPE("GlRenderer::flush_2d");
+		// Buffers grow geometrically to avoid reallocating them on every slightly bigger batch.
+		if (vertices.size_bytes() > _2d_vbo.size())
+		{
+			_2d_vbo.initialize(GL_DYNAMIC_DRAW, std::max<size_t>(vertices.size_bytes(), 2 * _2d_vbo.size()), nullptr);
+			++_counters._buffer_reallocations;
+		}
+		_2d_vbo.write(0, vertices.size_bytes(), vertices.data());
 
-		if (indices.capacity() > _2d_ibo.size())
-			_2d_ibo.initialize(GL_DYNAMIC_DRAW, indices.capacity(), indices.data());
-		else
-			_2d_ibo.write(0, indices.size(), indices.data());
+		if (indices.size_bytes() > _2d_ibo.size())
+		{
+			_2d_ibo.initialize(GL_DYNAMIC_DRAW, std::max<size_t>(indices.size_bytes(), 2 * _2d_ibo.size()), nullptr);
+			++_counters._buffer_reallocations;
+		}
+		_2d_ibo.write(0, indices.size_bytes(), indices.data());
+		_counters._uploaded_bytes += vertices.size_bytes() + indices.size_bytes();
 
 		_2d_vao.bind();
 		_2d_ibo.bind();
-		_gl.DrawElements(GL_TRIANGLE_STRIP, static_cast<GLsizei>(indices.size() / sizeof(uint16_t)), GL_UNSIGNED_SHORT, nullptr);
+		_gl.DrawElements(GL_TRIANGLE_STRIP, static_cast<GLsizei>(indices.size()), GL_UNSIGNED_SHORT, nullptr);
 		_2d_ibo.unbind();
 		_2d_vao.unbind();
 	}
@@ -258,22 +272,22 @@ namespace Yt
 		switch (type)
 		{
 		case GL_DEBUG_TYPE_ERROR:
-			Logger::write(fmt::format("(OpenGL) Error! {}", message));
+			Y_LOG_ERROR(Driver, "(OpenGL) Error! {}", message);
 			break;
 		case GL_DEBUG_TYPE_DEPRECATED_BEHAVIOR:
-			Logger::write(fmt::format("(OpenGL) Deprecated behavior! {}", message));
+			Y_LOG_WARNING(Driver, "(OpenGL) Deprecated behavior! {}", message);
 			break;
 		case GL_DEBUG_TYPE_UNDEFINED_BEHAVIOR:
-			Logger::write(fmt::format("(OpenGL) Undefined behavior! {}", message));
+			Y_LOG_WARNING(Driver, "(OpenGL) Undefined behavior! {}", message);
 			break;
 		case GL_DEBUG_TYPE_PORTABILITY:
-			Logger::write(fmt::format("(OpenGL) Portability warning! {}", message));
+			Y_LOG_WARNING(Driver, "(OpenGL) Portability warning! {}", message);
 			break;
 		case GL_DEBUG_TYPE_PERFORMANCE:
-			Logger::write(fmt::format("(OpenGL) Performance warning! {}", message));
+			Y_LOG_WARNING(Driver, "(OpenGL) Performance warning! {}", message);
 			break;
 		default:
-			Logger::write(fmt::format("(OpenGL) ", message));
+			Y_LOG_DEBUG(Driver, "(OpenGL) {}", message);
 			stop = false;
 			break;
 		}
@@ -12,8 +12,6 @@
 #include <array>
 #include <stdexcept>
 
-#include <fmt/format.h>
-
 namespace
 {
 	void print_vulkan_layers_available()
@@ -22,10 +20,10 @@ namespace
 		Y_VK_CHECK(vkEnumerateInstanceLayerProperties(&count, nullptr));
 		std::vector<VkLayerProperties> layers(count);
 		Y_VK_CHECK(vkEnumerateInstanceLayerProperties(&count, layers.data()));
-		Yt::Logger::write("Vulkan layers available:");
+		Y_LOG_DEBUG(Driver, "Vulkan layers available:");
 		for (const auto& layer : layers)
-			Yt::Logger::write(fmt::format("  {} - {}", layer.layerName, layer.description));
-		Yt::Logger::write("");
+			Y_LOG_DEBUG(Driver, "  {} - {}", layer.layerName, layer.description);
+		Y_LOG_DEBUG(Driver, "");
 	}
 
 	VkInstance create_vulkan_instance()
@@ -74,7 +72,7 @@ namespace
 #ifndef NDEBUG
 	VKAPI_ATTR VkBool32 VKAPI_CALL print_vulkan_debug_report(VkDebugReportFlagsEXT, VkDebugReportObjectTypeEXT, uint64_t, size_t, int32_t, const char* layer_prefix, const char* message, void*)
 	{
-		Yt::Logger::write(fmt::format("[{}] {}", layer_prefix, message));
+		Y_LOG_WARNING(Driver, "[{}] {}", layer_prefix, message);
 		return VK_FALSE;
 	}
 
@@ -168,14 +166,14 @@ namespace
 			{ VK_FORMAT_R16G16B16A16_UNORM, "VK_FORMAT_R16G16B16A16_UNORM" },
 		};
 
-		Yt::Logger::write("Vulkan texture formats supported:");
+		Y_LOG_DEBUG(Driver, "Vulkan texture formats supported:");
 		for (const auto& [format_id, format_name] : formats)
 		{
 			VkFormatProperties properties;
 			vkGetPhysicalDeviceFormatProperties(device, format_id, &properties);
-			Yt::Logger::write(fmt::format("  {} {} ({})", (properties.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT) ? '+' : '-', format_name, format_id));
+			Y_LOG_DEBUG(Driver, "  {} {} ({})", (properties.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT) ? '+' : '-', format_name, format_id);
 		}
-		Yt::Logger::write("");
+		Y_LOG_DEBUG(Driver, "");
 	}
 
 	VkDevice create_vulkan_device(VkPhysicalDevice physical_device, uint32_t queue_family_index)
@@ -400,14 +398,16 @@ namespace Yt
 
 	void VulkanContext::Data::create(const WindowID& window_id)
 	{
-		::print_vulkan_layers_available();
+		if (Logger::enabled(LogLevel::Debug, LogCategory::Driver))
+			::print_vulkan_layers_available();
 		_instance = ::create_vulkan_instance();
 #ifndef NDEBUG
 		std::tie(_debug_report_callback, _destroy_debug_report_callback) = ::create_vulkan_debug_report_callback(_instance);
 #endif
 		_surface = ::create_vulkan_surface(_instance, window_id);
 		std::tie(_physical_device, _queue_family_index) = ::select_vulkan_physical_device(_instance, _surface);
-		::print_vulkan_texture_formats(_physical_device);
+		if (Logger::enabled(LogLevel::Debug, LogCategory::Driver))
+			::print_vulkan_texture_formats(_physical_device);
 		vkGetPhysicalDeviceFeatures(_physical_device, &_physical_device_features);
 		vkGetPhysicalDeviceMemoryProperties(_physical_device, &_physical_device_memory_properties);
 		Y_VK_CHECK(vkGetPhysicalDeviceSurfaceCapabilitiesKHR(_physical_device, _surface, &_surface_capabilities));
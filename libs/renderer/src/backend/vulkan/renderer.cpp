@@ -83,20 +83,22 @@ namespace Yt
 
 	std::unique_ptr<Mesh> VulkanRenderer::create_mesh(const MeshData& data)
 	{
-		const auto vertex_buffer_size = data._vertex_data.size() * vertex_format(data._vertex_format)._binding.stride;
+		const auto vertex_buffer_size = data._vertex_data.size_bytes();
 
 		if (Buffer index_data; data.make_uint16_indices(index_data))
 		{
 			auto result = std::make_unique<VulkanMesh>(_context, vertex_buffer_size, index_data.size(), VK_INDEX_TYPE_UINT16, data._indices.size());
 			result->_vertex_buffer.write(data._vertex_data.data(), vertex_buffer_size);
 			result->_index_buffer.write(index_data.data(), index_data.size());
+			_counters._uploaded_bytes += vertex_buffer_size + index_data.size();
 			return result;
 		}
 
-		const auto index_buffer_size = data._indices.size() * sizeof(uint32_t);
+		const auto index_buffer_size = data._indices.size_bytes();
 		auto result = std::make_unique<VulkanMesh>(_context, vertex_buffer_size, index_buffer_size, VK_INDEX_TYPE_UINT32, data._indices.size());
 		result->_vertex_buffer.write(data._vertex_data.data(), vertex_buffer_size);
 		result->_index_buffer.write(data._indices.data(), index_buffer_size);
+		_counters._uploaded_bytes += vertex_buffer_size + index_buffer_size;
 		return result;
 	}
 
@@ -116,7 +118,7 @@ namespace Yt
 		return 0;
 	}
 
-	void VulkanRenderer::flush_2d(const Buffer&, const Buffer&) noexcept
+	void VulkanRenderer::flush_2d(std::span<const Vertex2D>, std::span<const uint16_t>) noexcept
 	{
 	}
 
@@ -29,7 +29,7 @@ namespace Yt
 		std::unique_ptr<RenderProgram> create_program(const std::string& vertex_shader, const std::string& fragment_shader) override;
 		std::unique_ptr<Texture2D> create_texture_2d(const seir::ImageInfo&, const void*, Flags<RenderManager::TextureFlag>) override;
 		size_t draw_mesh(const Mesh&) override;
-		void flush_2d(const Buffer&, const Buffer&) noexcept override;
+		void flush_2d(std::span<const Vertex2D>, std::span<const uint16_t>) noexcept override;
 		RectF map_rect(const RectF&, ImageOrientation) const override;
 		void set_program(const RenderProgram*) override;
 		void set_texture(const Texture2D&, Flags<Texture2D::Filter>) override;
@@ -4,11 +4,10 @@
 
 #include "obj.h"
 
-#include <yttrium/base/buffer_appender.h>
 #include <yttrium/base/exceptions.h>
+#include <yttrium/base/profiler.h>
 #include "../mesh_data.h"
 
-#include <seir_data/reader.hpp>
 #include <seir_math/vec.hpp>
 
 #include <optional>
@@ -150,18 +149,28 @@ namespace
 			const auto i = std::find(_indices.cbegin(), _indices.cend(), index);
 			if (i != _indices.cend())
 			{
-				data._indices.emplace_back(static_cast<uint32_t>(i - _indices.cbegin()));
+				data._indices.push_back(static_cast<uint32_t>(i - _indices.cbegin()));
 				return true;
 			}
 
-			Yt::BufferAppender<float> appender(data._vertex_data);
-			appender << _vertices[index_v].x << _vertices[index_v].y << _vertices[index_v].z;
+			auto& vertex_data = data._vertex_data;
+			vertex_data.reserve(vertex_data.size() + 8);
+			vertex_data.push_back_unsafe(_vertices[index_v].x);
+			vertex_data.push_back_unsafe(_vertices[index_v].y);
+			vertex_data.push_back_unsafe(_vertices[index_v].z);
 			if (index_t != _no_index)
-				appender << _texcoords[index_t].x << _texcoords[index_t].y;
+			{
+				vertex_data.push_back_unsafe(_texcoords[index_t].x);
+				vertex_data.push_back_unsafe(_texcoords[index_t].y);
+			}
 			if (index_n != _no_index)
-				appender << _normals[index_n].x << _normals[index_n].y << _normals[index_n].z;
+			{
+				vertex_data.push_back_unsafe(_normals[index_n].x);
+				vertex_data.push_back_unsafe(_normals[index_n].y);
+				vertex_data.push_back_unsafe(_normals[index_n].z);
+			}
 
-			data._indices.emplace_back(static_cast<uint32_t>(_indices.size()));
+			data._indices.push_back(static_cast<uint32_t>(_indices.size()));
 			_indices.emplace_back(index);
 			return true;
 		}
@@ -188,17 +197,18 @@ namespace
 
 namespace Yt
 {
-	MeshData load_obj_mesh(const seir::Blob& blob, std::string_view source_name)
+	MeshData load_obj_mesh(std::string_view text, std::string_view source_name)
 	{
+		Y_PROFILE_SCOPE("load_obj_mesh");
 		MeshData result;
 		std::string line;
 		size_t line_number = 0;
 		ObjState state;
-		for (seir::Reader reader{ blob };;)
+		while (!text.empty())
 		{
-			line = reader.readLine();
-			if (line.empty())
-				break;
+			const auto line_end = text.find('\n');
+			line.assign(text.substr(0, line_end));
+			text.remove_prefix(line_end == std::string_view::npos ? text.size() : line_end + 1);
 			++line_number;
 			if (std::regex_match(line, _obj_empty_regex))
 				continue;
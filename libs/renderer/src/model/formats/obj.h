@@ -6,14 +6,9 @@
 
 #include <string_view>
 
-namespace seir
-{
-	class Blob;
-}
-
 namespace Yt
 {
 	class MeshData;
 
-	MeshData load_obj_mesh(const seir::Blob&, std::string_view source_name);
+	MeshData load_obj_mesh(std::string_view text, std::string_view source_name);
 }
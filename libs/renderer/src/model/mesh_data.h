@@ -4,7 +4,7 @@
 
 #pragma once
 
-#include <yttrium/base/buffer.h>
+#include <yttrium/base/buffer_vector.h>
 
 #include <vector>
 
@@ -23,8 +23,8 @@ namespace Yt
 	{
 	public:
 		std::vector<VA> _vertex_format;
-		Buffer _vertex_data;
-		std::vector<uint32_t> _indices;
+		BufferVector<float> _vertex_data;
+		BufferVector<uint32_t> _indices;
 
 		bool make_uint16_indices(Buffer&) const;
 	};
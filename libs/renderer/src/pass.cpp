@@ -4,6 +4,7 @@
 
 #include "pass.h"
 
+#include <yttrium/base/profiler.h>
 #include <yttrium/renderer/metrics.h>
 #include <yttrium/renderer/program.h>
 #include "backend/backend.h"
@@ -14,11 +15,12 @@
 #include <seir_math/line.hpp>
 #include <seir_math/mat.hpp>
 
+#include <algorithm>
+#include <bit>
 #include <cassert>
-
-#ifndef NDEBUG
-#	include <algorithm>
-#endif
+#include <cstdint>
+#include <new>
+#include <utility>
 
 namespace
 {
@@ -33,6 +35,54 @@ namespace
 
 namespace Yt
 {
+	void PointerSet::clear() noexcept
+	{
+		if (_size > 0)
+		{
+			std::fill(_slots.begin(), _slots.end(), nullptr);
+			_size = 0;
+		}
+		_has_null = false;
+	}
+
+	bool PointerSet::insert(const void* pointer) noexcept
+	{
+		if (!pointer)
+			return !std::exchange(_has_null, true);
+		if (!_slots.empty() && _slots[find(pointer)])
+			return false;
+		if (2 * (_size + 1) > _slots.size())
+		{
+			// Keeping the load factor at most one half makes probe sequences short.
+			std::vector<const void*> new_slots;
+			try
+			{
+				new_slots.resize(std::max<size_t>(2 * _slots.size(), 16), nullptr);
+			}
+			catch (const std::bad_alloc&)
+			{
+				return true; // Redundancy statistics aren't worth failing the frame.
+			}
+			const auto old_slots = std::exchange(_slots, std::move(new_slots));
+			_shift = 64 - std::countr_zero(_slots.size());
+			for (const auto old_pointer : old_slots)
+				if (old_pointer)
+					_slots[find(old_pointer)] = old_pointer;
+		}
+		_slots[find(pointer)] = pointer;
+		++_size;
+		return true;
+	}
+
+	size_t PointerSet::find(const void* pointer) const noexcept
+	{
+		// Fibonacci hashing spreads aligned pointers over the whole table.
+		const auto mask = _slots.size() - 1;
+		for (auto i = static_cast<size_t>((reinterpret_cast<uintptr_t>(pointer) * uint64_t{ 0x9E3779B97F4A7C15 }) >> _shift);; i = (i + 1) & mask)
+			if (_slots[i] == pointer || !_slots[i])
+				return i;
+	}
+
 	RenderPassData::RenderPassData() = default;
 
 	RenderPassData::~RenderPassData() noexcept = default;
@@ -44,22 +94,24 @@ namespace Yt
 		, _viewport_size{ viewport_size }
 		, _metrics{ metrics }
 	{
+		const auto start = std::chrono::steady_clock::now();
 		_backend.clear();
+		_submission_time += std::chrono::steady_clock::now() - start;
 	}
 
 	RenderPassImpl::~RenderPassImpl() noexcept
 	{
-#ifndef NDEBUG
 		_data._seen_textures.clear();
 		_data._seen_programs.clear();
-#endif
 	}
 
 	void RenderPassImpl::draw_mesh(const Mesh& mesh)
 	{
+		const auto start = std::chrono::steady_clock::now();
 		update_state();
 		_metrics._triangles += _backend.draw_mesh(mesh);
 		++_metrics._draw_calls;
+		_submission_time += std::chrono::steady_clock::now() - start;
 	}
 
 	seir::Mat4 RenderPassImpl::full_matrix() const
@@ -198,12 +250,17 @@ namespace Yt
 		_data._matrix_stack.emplace_back(_data._matrix_stack.back().first * matrix, RenderMatrixType::Model);
 	}
 
-	void RenderPassImpl::flush_2d(const Buffer& vertices, const Buffer& indices) noexcept
+	void RenderPassImpl::flush_2d(std::span<const Vertex2D> vertices, std::span<const uint16_t> indices) noexcept
 	{
+		Y_PROFILE_SCOPE("RenderPassImpl::flush_2d");
+		const auto start = std::chrono::steady_clock::now();
 		update_state();
 		_backend.flush_2d(vertices, indices);
-		_metrics._triangles += indices.size() / sizeof(uint16_t) - 2;
+		_metrics._triangles += indices.size() - 2;
 		++_metrics._draw_calls;
+		++_metrics._2d_parts;
+		_metrics._2d_vertices += vertices.size();
+		_submission_time += std::chrono::steady_clock::now() - start;
 	}
 
 	void RenderPassImpl::update_state()
@@ -217,12 +274,8 @@ namespace Yt
 				_current_program = program;
 				_backend.set_program(program);
 				++_metrics._shader_switches;
-#ifndef NDEBUG
-				if (std::none_of(_data._seen_programs.begin(), _data._seen_programs.end(), [program](const auto seen_program) { return program == seen_program; }))
-					_data._seen_programs.emplace_back(program);
-				else
+				if (!_data._seen_programs.insert(program))
 					++_metrics._extra_shader_switches;
-#endif
 			}
 		}
 
@@ -235,12 +288,8 @@ namespace Yt
 				_current_texture = texture;
 				_backend.set_texture(*texture, _current_texture_filter);
 				++_metrics._texture_switches;
-#ifndef NDEBUG
-				if (std::none_of(_data._seen_textures.begin(), _data._seen_textures.end(), [texture](const auto seen_texture) { return texture == seen_texture; }))
-					_data._seen_textures.emplace_back(texture);
-				else
+				if (!_data._seen_textures.insert(texture))
 					++_metrics._extra_texture_switches;
-#endif
 			}
 		}
 	}
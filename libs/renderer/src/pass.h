@@ -6,13 +6,16 @@
 
 #include <yttrium/renderer/pass.h>
 
-#include <yttrium/base/buffer.h>
 #include <yttrium/base/flags.h>
 #include <yttrium/renderer/texture.h>
+#include "2d.h"
 
 #include <seir_graphics/sizef.hpp>
 
+#include <chrono>
+#include <span>
 #include <string>
+#include <vector>
 
 namespace Yt
 {
@@ -30,6 +33,25 @@ namespace Yt
 		Model,
 	};
 
+	// Open addressing set of pointers which keeps its capacity when cleared.
+	class PointerSet
+	{
+	public:
+		void clear() noexcept;
+		// Returns false if the pointer is already in the set.
+		// If the set can't grow, the pointer isn't inserted, and true is returned.
+		bool insert(const void*) noexcept;
+
+	private:
+		size_t find(const void*) const noexcept;
+
+	private:
+		std::vector<const void*> _slots;
+		size_t _size = 0;
+		int _shift = 0;
+		bool _has_null = false; // Empty slots are null.
+	};
+
 	// Data that persists between frames.
 	class RenderPassData
 	{
@@ -40,13 +62,9 @@ namespace Yt
 	private:
 		std::vector<std::pair<seir::Mat4, RenderMatrixType>> _matrix_stack;
 		std::vector<std::pair<const Texture2D*, int>> _texture_stack{ { nullptr, 1 } };
-#ifndef NDEBUG
-		std::vector<const Texture2D*> _seen_textures; // For redundancy statistics.
-#endif
+		PointerSet _seen_textures; // For redundancy statistics.
 		std::vector<std::pair<const RenderProgram*, int>> _program_stack{ { nullptr, 1 } };
-#ifndef NDEBUG
-		std::vector<const RenderProgram*> _seen_programs; // For redundancy statistics.
-#endif
+		PointerSet _seen_programs; // For redundancy statistics.
 		friend class RenderPassImpl;
 	};
 
@@ -64,7 +82,7 @@ namespace Yt
 
 	public:
 		RenderBuiltin& builtin() const noexcept { return _builtin; }
-		void flush_2d(const Buffer& vertices, const Buffer& indices) noexcept;
+		void flush_2d(std::span<const Vertex2D> vertices, std::span<const uint16_t> indices) noexcept;
 		void pop_program() noexcept;
 		void pop_projection() noexcept;
 		void pop_texture(Flags<Texture2D::Filter>) noexcept;
@@ -74,6 +92,7 @@ namespace Yt
 		void push_projection_3d(const seir::Mat4& projection, const seir::Mat4& view);
 		Flags<Texture2D::Filter> push_texture(const Texture2D*, Flags<Texture2D::Filter>);
 		void push_transformation(const seir::Mat4&);
+		std::chrono::steady_clock::duration submission_time() const noexcept { return _submission_time; }
 
 	private:
 		void update_state();
@@ -84,6 +103,7 @@ namespace Yt
 		RenderPassData& _data;
 		const seir::SizeF _viewport_size;
 		RenderMetrics& _metrics;
+		std::chrono::steady_clock::duration _submission_time{ 0 };
 
 		const Texture2D* _current_texture = nullptr;
 		Flags<Texture2D::Filter> _current_texture_filter = Texture2D::NearestFilter;
@@ -4,6 +4,8 @@
 
 #include "renderer.h"
 
+#include <yttrium/base/exceptions.h>
+#include <yttrium/base/shared_buffer.h>
 #include <yttrium/renderer/mesh.h>
 #include <yttrium/renderer/program.h>
 #include "model/formats/obj.h"
@@ -17,11 +19,14 @@
 #	include "backend/null/renderer.h"
 #endif
 
+#include <seir_data/blob.hpp>
 #include <seir_graphics/rectf.hpp>
 #include <seir_image/image.hpp>
 
 #include <cassert>
 
+#include <fmt/format.h>
+
 // TODO: Load textures without intermediate Images.
 
 namespace Yt
@@ -51,9 +56,25 @@ namespace Yt
 		return _backend->create_texture_2d(image.info(), image.data(), flags);
 	}
 
+	std::unique_ptr<Texture2D> RendererImpl::create_texture_2d(const seir::ImageInfo& info, const SharedBuffer& buffer, Flags<TextureFlag> flags)
+	{
+		if (buffer.size() < info.frameSize())
+			throw DataError{ fmt::format("Not enough texture data ({} bytes instead of {})", buffer.size(), info.frameSize()) };
+		return _backend->create_texture_2d(info, buffer.data(), flags);
+	}
+
 	std::unique_ptr<Mesh> RendererImpl::load_mesh(const seir::Blob& blob, std::string_view source_name)
 	{
-		const auto data = load_obj_mesh(blob, source_name);
+		return create_mesh(load_obj_mesh({ static_cast<const char*>(blob.data()), blob.size() }, source_name));
+	}
+
+	std::unique_ptr<Mesh> RendererImpl::load_mesh(const SharedBuffer& buffer, std::string_view source_name)
+	{
+		return create_mesh(load_obj_mesh({ static_cast<const char*>(buffer.data()), buffer.size() }, source_name));
+	}
+
+	std::unique_ptr<Mesh> RendererImpl::create_mesh(const MeshData& data)
+	{
 		assert(!data._vertex_format.empty());
 		assert(data._vertex_data.size() > 0);
 		assert(!data._indices.empty());
@@ -18,6 +18,7 @@ namespace seir
 namespace Yt
 {
 	enum class ImageOrientation;
+	class MeshData;
 	class RenderBackend;
 	struct WindowID;
 
@@ -29,7 +30,9 @@ namespace Yt
 
 		std::unique_ptr<RenderProgram> create_program(const std::string& vertex_shader, const std::string& fragment_shader) override;
 		std::unique_ptr<Texture2D> create_texture_2d(const seir::Image&, Flags<TextureFlag>) override;
+		std::unique_ptr<Texture2D> create_texture_2d(const seir::ImageInfo&, const SharedBuffer&, Flags<TextureFlag>) override;
 		std::unique_ptr<Mesh> load_mesh(const seir::Blob&, std::string_view source_name) override;
+		std::unique_ptr<Mesh> load_mesh(const SharedBuffer&, std::string_view source_name) override;
 
 	public:
 		seir::RectF map_rect(const seir::RectF&, seir::ImageAxes) const;
@@ -38,5 +41,8 @@ namespace Yt
 
 	public:
 		const std::unique_ptr<RenderBackend> _backend;
+
+	private:
+		std::unique_ptr<Mesh> create_mesh(const MeshData&);
 	};
 }
@@ -3,10 +3,14 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include <yttrium/renderer/viewport.h>
+
+#include <yttrium/base/profiler.h>
 #include "viewport.h"
 
 #include <seir_image/image.hpp>
 
+#include <algorithm>
+
 namespace Yt
 {
 	Viewport::Viewport(Window& window)
@@ -16,13 +20,72 @@ namespace Yt
 
 	Viewport::~Viewport() noexcept = default;
 
+	FrameArena& Viewport::frame_arena() noexcept
+	{
+		return _data->_frame_arena;
+	}
+
+	FrameTimeStatistics Viewport::frame_time_statistics() const noexcept
+	{
+		FrameTimeStatistics result;
+		result._frames = std::min(_data->_frame_count, FrameTimeStatistics::MaxFrames);
+		if (!result._frames)
+			return result;
+		std::array<std::chrono::nanoseconds, FrameTimeStatistics::MaxFrames> values;
+		for (const auto phase : { &FrameTimings::_interval, &FrameTimings::_callback, &FrameTimings::_submission, &FrameTimings::_present, &FrameTimings::_total })
+		{
+			for (size_t i = 0; i < result._frames; ++i)
+				values[i] = _data->_frame_timings[i].*phase;
+			std::sort(values.begin(), values.begin() + static_cast<ptrdiff_t>(result._frames));
+			const auto percentile = [&values, frames = result._frames](size_t percent) { return values[(frames * percent + 99) / 100 - 1]; };
+			result._p50.*phase = percentile(50);
+			result._p95.*phase = percentile(95);
+			result._p99.*phase = percentile(99);
+			result._max.*phase = values[result._frames - 1];
+		}
+		// The first frame has no interval, and the oldest recorded one has no previous frame.
+		const auto first = _data->_frame_count - result._frames + (_data->_frame_count == result._frames ? 1 : 0);
+		std::chrono::nanoseconds jitter_sum{ 0 };
+		size_t jitter_count = 0;
+		for (auto i = first + 1; i < _data->_frame_count; ++i)
+		{
+			const auto current = _data->_frame_timings[i % FrameTimeStatistics::MaxFrames]._interval;
+			const auto previous = _data->_frame_timings[(i - 1) % FrameTimeStatistics::MaxFrames]._interval;
+			jitter_sum += current > previous ? current - previous : previous - current;
+			++jitter_count;
+		}
+		if (jitter_count > 0)
+			result._jitter = jitter_sum / static_cast<std::chrono::nanoseconds::rep>(jitter_count);
+		return result;
+	}
+
+	FrameTimings Viewport::frame_timings() const noexcept
+	{
+		return _data->_frame_count > 0 ? _data->_frame_timings[(_data->_frame_count - 1) % FrameTimeStatistics::MaxFrames] : FrameTimings{};
+	}
+
 	RenderMetrics Viewport::metrics() const noexcept
 	{
 		return _data->_metrics;
 	}
 
+	size_t Viewport::metrics_history(std::span<RenderMetrics> metrics) const noexcept
+	{
+		const auto count = std::min({ metrics.size(), _data->_frame_count, FrameTimeStatistics::MaxFrames });
+		for (size_t i = 0; i < count; ++i)
+			metrics[i] = _data->_frame_metrics[(_data->_frame_count - count + i) % FrameTimeStatistics::MaxFrames];
+		return count;
+	}
+
 	void Viewport::render(const std::function<void(RenderPass&)>& callback)
 	{
+		Y_PROFILE_SCOPE("Viewport::render");
+		using Clock = std::chrono::steady_clock;
+		const auto frame_start = Clock::now();
+		FrameTimings timings;
+		if (_data->_frame_count > 0)
+			timings._interval = frame_start - _data->_frame_start;
+		_data->_frame_start = frame_start;
 		const auto window_size = _data->_window.size();
 		if (window_size != _data->_window_size)
 		{
@@ -31,10 +94,30 @@ namespace Yt
 		}
 		_data->_metrics = RenderMetrics{};
 		{
+			const auto pass_start = Clock::now();
 			RenderPassImpl pass{ *_data->_renderer._backend, _data->_renderer_builtin, _data->_render_pass_data, window_size, _data->_metrics };
 			callback(pass);
+			timings._submission = pass.submission_time();
+			timings._callback = Clock::now() - pass_start - timings._submission;
 		}
+		const auto present_start = Clock::now();
 		_data->_window.swap_buffers();
+		timings._present = Clock::now() - present_start;
+		_data->_frame_arena.next_frame();
+		// Frame bookkeeping uses only the memory allocated with the viewport.
+		Y_NO_ALLOCATIONS("Viewport::render");
+		timings._total = Clock::now() - frame_start;
+		const auto counters = _data->_renderer._backend->counters();
+		_data->_metrics._uploaded_bytes = counters._uploaded_bytes - _data->_backend_counters._uploaded_bytes;
+		_data->_metrics._buffer_reallocations = counters._buffer_reallocations - _data->_backend_counters._buffer_reallocations;
+		_data->_backend_counters = counters;
+		const auto allocations = AllocationTracker::counters();
+		_data->_metrics._cpu_allocations = static_cast<size_t>(allocations._buffer_allocations - _data->_allocation_counters._buffer_allocations
+			+ allocations._heap_allocations - _data->_allocation_counters._heap_allocations);
+		_data->_allocation_counters = allocations;
+		const auto frame = _data->_frame_count++ % FrameTimeStatistics::MaxFrames;
+		_data->_frame_timings[frame] = timings;
+		_data->_frame_metrics[frame] = _data->_metrics;
 	}
 
 	RenderManager& Viewport::render_manager()
@@ -3,11 +3,17 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include <yttrium/application/window.h>
+#include <yttrium/base/allocation_tracker.h>
+#include <yttrium/base/frame_arena.h>
 #include <yttrium/renderer/metrics.h>
+#include "backend/backend.h"
 #include "builtin.h"
 #include "pass.h"
 #include "renderer.h"
 
+#include <array>
+#include <chrono>
+
 namespace Yt
 {
 	struct ViewportData
@@ -18,6 +24,13 @@ namespace Yt
 		RenderBuiltin _renderer_builtin{ *_renderer._backend };
 		RenderPassData _render_pass_data;
 		RenderMetrics _metrics;
+		FrameArena _frame_arena{ 2 };
+		std::array<FrameTimings, FrameTimeStatistics::MaxFrames> _frame_timings;
+		std::array<RenderMetrics, FrameTimeStatistics::MaxFrames> _frame_metrics;
+		RenderBackendCounters _backend_counters;
+		AllocationCounters _allocation_counters = AllocationTracker::counters();
+		size_t _frame_count = 0;
+		std::chrono::steady_clock::time_point _frame_start;
 
 		explicit ViewportData(Window& window)
 			: _window{ window } {}